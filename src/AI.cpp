@@ -16,16 +16,22 @@ namespace AI
     { Game::TYPE_ID::rock, 1 },
     { Game::TYPE_ID::tree, 1 }
   };
-void get_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources)
+  float level_width = Game::WIDTH;
+
+  void set_level_width(float width)
+  {
+    level_width = width;
+  }
+void get_action(Entity& me, std::list<Entity*> &surroundings)
   {   
     switch (me.getTypeId())
       {
       case Game::TYPE_ID::airplane:
-	return get_airplane_action(me, surroundings, resources);
+	return get_airplane_action(me, surroundings);
       case Game::TYPE_ID::antiaircraft:
-	return get_antiaircraft_action(me, surroundings, resources);
+	return get_antiaircraft_action(me, surroundings);
       case Game::TYPE_ID::infantry:
-	return get_infantry_action(me, surroundings,resources);
+	return get_infantry_action(me, surroundings);
       default:
 	return ;
       }
@@ -43,19 +49,21 @@ void get_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager &
 	me.moveUp();
     }
   // NOTICE current_worse_enemy was supposed to be Entity pointer, but we encountered a nasty problem: right after set_target-function call current_worse_enemy was assigned back to null pointer???
-void get_airplane_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources)
+void get_airplane_action(Entity& me, std::list<Entity*> &surroundings)
   {
     sf::Vector2f current_worse_enemy = {-1.f,-1.f};
     int current_worse_enemy_priority = -1;
     sf::Vector2f my_position = me.getPosition();
+    // RIGHT_LIMIT is relative to the right edge of the level
+    const float right_limit = level_width - (Game::WIDTH - Game::RIGHT_LIMIT);
     set_target(me, surroundings, current_worse_enemy, current_worse_enemy_priority);
-    if( my_position.x < Game::LEFT_LIMIT || my_position.x > Game::RIGHT_LIMIT || my_position.y < Game::LOWER_LIMIT || my_position.x > Game::UPPER_LIMIT )
+    if( my_position.x < Game::LEFT_LIMIT || my_position.x > right_limit || my_position.y < Game::LOWER_LIMIT || my_position.x > Game::UPPER_LIMIT )
       {
 	if ( my_position.x < Game::LEFT_LIMIT )
 	  {	    
 	    me.moveRight();
 	  }
-	if ( my_position.x > Game::RIGHT_LIMIT )
+	if ( my_position.x > right_limit )
 	  {
 	    me.moveLeft();
 	  }
@@ -83,12 +91,16 @@ void get_airplane_action(Entity& me, std::list<Entity*> &surroundings, ResourceM
                   float scale = sqrt(pow(std::abs(direction.x),2)+pow(std::abs(direction.y),2));
                   direction.x = direction.x/scale;
                   direction.y = direction.y/scale;
-		  me.shoot(direction, resources);
+		  me.shoot(direction);
 		  return;
 		}
 	      default:
-		{                  
-                  me.shoot(sf::Vector2f(0.f, 1.f), resources);		  
+		{
+                  // bomb ground targets below, shoot when out of bombs
+                  if (current_worse_enemy.y <= my_position.y || ! me.dropBomb())
+                  {
+                    me.shoot(sf::Vector2f(0.f, 1.f));
+                  }
 		  return;
 		}
 	      }
@@ -120,7 +132,7 @@ void get_airplane_action(Entity& me, std::list<Entity*> &surroundings, ResourceM
       }
   }
 
-void get_antiaircraft_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources)
+void get_antiaircraft_action(Entity& me, std::list<Entity*> &surroundings)
   {
     sf::Vector2f current_worse_enemy =  {-1.0f,-1.0};
     sf::Vector2f my_position = me.getPosition();
@@ -140,18 +152,18 @@ void get_antiaircraft_action(Entity& me, std::list<Entity*> &surroundings, Resou
         float scale = sqrt(pow(std::abs(direction.x),2)+pow(std::abs(direction.y),2));
         direction.x = direction.x/scale;
         direction.y = direction.y/scale;
-	me.shoot(direction, resources);
+	me.shoot(direction);
       }
   }
 
-void get_infantry_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources)
+void get_infantry_action(Entity& me, std::list<Entity*> &surroundings)
   {
     sf::Vector2f current_worse_enemy = {-1.0f,-1.0};
     int current_worse_enemy_priority = 0;
     sf::Vector2f my_position = me.getPosition();
     set_target(me, surroundings, current_worse_enemy, current_worse_enemy_priority);
     const int EPSILON = 50;
-    if( my_position.x < EPSILON || my_position.x >= Game::WIDTH - EPSILON)
+    if( my_position.x < EPSILON || my_position.x >= level_width - EPSILON)
       {
 	if ( my_position.x < EPSILON )
 	  {
@@ -172,7 +184,7 @@ void get_infantry_action(Entity& me, std::list<Entity*> &surroundings, ResourceM
             float scale = sqrt(pow(std::abs(direction.x),2)+pow(std::abs(direction.y),2));
             direction.x = direction.x/scale;
             direction.y = direction.y/scale;
-	    me.shoot(direction, resources);
+	    me.shoot(direction);
 	    if(direction.x > 0)
 	      me.moveLeft();
 	    else me.moveRight();
@@ -12,11 +12,18 @@
   */
 namespace AI {
   extern std::map<Game::TYPE_ID, int> priority_list;
+  extern float level_width;
 
-void get_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources);
-void get_airplane_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources);
-void get_antiaircraft_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources);
-void get_infantry_action(Entity& me, std::list<Entity*> &surroundings, ResourceManager & resources);
+  /**
+    *   @brief Set level width used for the AI movement limits
+    *   @param width Right most point of the level
+    */
+  void set_level_width(float width);
+
+void get_action(Entity& me, std::list<Entity*> &surroundings);
+void get_airplane_action(Entity& me, std::list<Entity*> &surroundings);
+void get_antiaircraft_action(Entity& me, std::list<Entity*> &surroundings);
+void get_infantry_action(Entity& me, std::list<Entity*> &surroundings);
   void set_target(Entity& me, std::list<Entity*> &surroundings, sf::Vector2f & current_worse_enemy, int &current_worse_enemy_priority);
   bool is_too_close(sf::Vector2f & e1, sf::Vector2f & e2);
   void move_to_direction(Entity& me);
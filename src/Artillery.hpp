@@ -8,7 +8,6 @@
 
 #include <SFML/Graphics.hpp>
 #include "Entity.hpp"
-#include "Bullet.hpp"
 /**
   *   @class Artillery
   *   @brief Entity based Artillery objects
@@ -24,13 +23,13 @@ class Artillery : public Entity {
    *   @param b Artillerys body for collisions
    *   @param t Artillerys texture
    *   @param position Place as vector where artillery is created
-   *   @param team Artillerys team
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Artillery(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position, Game::TEAM_ID team);
+  Artillery(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 
     /**
      *   @brief give permission for object to shoot
      *   @return Return true or false based on if the object can shoot or not
      */
-  virtual bool shoot(sf::Vector2f direction, ResourceManager& resources) override;
+  virtual bool shoot(sf::Vector2f direction) override;
 };
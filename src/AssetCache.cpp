@@ -0,0 +1,162 @@
+/**
+  *   @file AssetCache.cpp
+  *   @brief Source code for class AssetCache
+  */
+
+#include "AssetCache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+  float Milliseconds(AssetCache::Clock::duration duration)
+  {
+    return std::chrono::duration<float, std::milli>(duration).count();
+  }
+}
+
+AssetCache& AssetCache::instance()
+{
+  static AssetCache cache(Paths::Paths[Paths::PATHS::img]);
+  return cache;
+}
+
+AssetCache::AssetCache(const std::string& directory) : directory(directory)
+{
+}
+
+TextureHandle AssetCache::acquire(Textures::ID id)
+{
+  return acquire(std::vector<Textures::ID>{id}).front();
+}
+
+std::vector<TextureHandle> AssetCache::acquire(const std::vector<Textures::ID>& ids)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  std::array<TextureHandle, Textures::id_end> loaded;
+  Load(ids, loaded);
+  std::vector<TextureHandle> handles;
+  handles.reserve(ids.size());
+  for (Textures::ID id : ids)
+  {
+    handles.push_back(loaded[id]);
+  }
+  return handles;
+}
+
+void AssetCache::Load(const std::vector<Textures::ID>& ids, std::array<TextureHandle, Textures::id_end>& loaded)
+{
+  std::vector<Textures::ID> missing;
+  for (Textures::ID id : ids)
+  {
+    if (loaded[id])
+    {
+      continue;
+    }
+    loaded[id] = textures[id].lock();
+    if (loaded[id])
+    {
+      hits++;
+    }
+    else if (std::find(missing.begin(), missing.end(), id) == missing.end())
+    {
+      missing.push_back(id);
+    }
+  }
+  if (missing.empty())
+  {
+    return;
+  }
+
+  // Decoding needs no OpenGL, files are shared by the threads
+  auto start = Clock::now();
+  std::vector<sf::Image> images(missing.size());
+  std::vector<char> decoded_ok(missing.size(), 0);
+  std::vector<Clock::duration> costs(missing.size());
+  std::atomic<std::size_t> next{0};
+  auto decode = [&]()
+  {
+    for (std::size_t i = next++; i < missing.size(); i = next++)
+    {
+      auto file_start = Clock::now();
+      decoded_ok[i] = images[i].loadFromFile(directory + Textures::TextureFiles[missing[i]]);
+      costs[i] = Clock::now() - file_start;
+    }
+  };
+  unsigned threads = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(missing.size())));
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < threads; i++)
+  {
+    workers.emplace_back(decode);
+  }
+  decode();
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+  auto uploaded = Clock::now();
+  decode_time += uploaded - start;
+
+  // Textures are created on this thread
+  for (std::size_t i = 0; i < missing.size(); i++)
+  {
+    auto texture = std::make_shared<sf::Texture>();
+    if (! decoded_ok[i] || ! texture->loadFromImage(images[i]))
+    {
+      std::cout << "AssetCache - Failed to load " << directory + Textures::TextureFiles[missing[i]] << std::endl;
+    }
+    textures[missing[i]] = texture;
+    loaded[missing[i]] = std::move(texture);
+    sequential_time += costs[i];
+  }
+  upload_time += Clock::now() - uploaded;
+  decoded += static_cast<int>(missing.size());
+  threads_used = std::max(threads_used, static_cast<int>(threads));
+}
+
+bool AssetCache::isLoaded(Textures::ID id) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return ! textures[id].expired();
+}
+
+void AssetCache::report(std::ostream& out) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  out << "assets: " << decoded << " of " << static_cast<int>(Textures::id_end) << " textures decoded in "
+      << Milliseconds(decode_time) << " ms on " << threads_used << " threads (" << Milliseconds(sequential_time)
+      << " ms one by one), uploaded in " << Milliseconds(upload_time) << " ms, " << hits
+      << " requests served from the cache" << std::endl;
+}
+
+int AssetCache::getDecodedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return decoded;
+}
+
+int AssetCache::getHitCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return hits;
+}
+
+float AssetCache::getDecodeMs() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return Milliseconds(decode_time);
+}
+
+float AssetCache::getSequentialDecodeMs() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return Milliseconds(sequential_time);
+}
+
+float AssetCache::getUploadMs() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return Milliseconds(upload_time);
+}
@@ -0,0 +1,126 @@
+/**
+  *   @file AssetCache.hpp
+  *   @brief Header for AssetCache class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+  *   @brief Reference counted texture, the cache frees it with the last handle
+  */
+using TextureHandle = std::shared_ptr<sf::Texture>;
+
+/**
+  *   @class AssetCache
+  *   @brief Textures shared by every ResourceManager of the process
+  *   @details Textures are loaded when they are first acquired, the cache
+  *   only keeps weak references. Acquiring many textures at once decodes the
+  *   PNG files in parallel on worker threads, the decoded images are uploaded
+  *   to textures on the calling thread, which must be able to use OpenGL.
+  *   A texture that is still in use is never decoded again.
+  */
+class AssetCache
+{
+  public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+      *   @return Returns the cache of the process, files are read from the image directory
+      */
+    static AssetCache& instance();
+
+    /**
+      *   @brief Constructor, nothing is loaded
+      *   @param directory Directory of the files in Textures::TextureFiles, ends with a slash
+      */
+    explicit AssetCache(const std::string& directory);
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    /**
+      *   @brief Get a texture, load it if nobody holds it
+      *   @details A file that can't be read gives an empty texture
+      *   @param id Texture id
+      *   @return Returns handle of the texture
+      */
+    TextureHandle acquire(Textures::ID id);
+
+    /**
+      *   @brief Get many textures, decode the missing ones in parallel
+      *   @param ids Texture ids, may contain duplicates
+      *   @return Returns handles in the order of ids
+      */
+    std::vector<TextureHandle> acquire(const std::vector<Textures::ID>& ids);
+
+    /**
+      *   @param id Texture id
+      *   @return Returns true if some handle of the texture is alive
+      */
+    bool isLoaded(Textures::ID id) const;
+
+    /**
+      *   @brief Print files decoded, time spent and requests served from the cache
+      *   @param out Stream written to
+      */
+    void report(std::ostream& out) const;
+
+    /**
+      *   @return Returns the amount of files decoded
+      */
+    int getDecodedCount() const;
+
+    /**
+      *   @return Returns the amount of requests served without decoding
+      */
+    int getHitCount() const;
+
+    /**
+      *   @return Returns wall time of decoding in milliseconds
+      */
+    float getDecodeMs() const;
+
+    /**
+      *   @return Returns the sum of the decoding times of the files in
+      *   milliseconds, the time decoding one by one would have taken
+      */
+    float getSequentialDecodeMs() const;
+
+    /**
+      *   @return Returns time of uploading the textures in milliseconds
+      */
+    float getUploadMs() const;
+
+  private:
+
+    /**
+      *   @brief Load the textures nobody holds
+      *   @param ids Texture ids, duplicates and loaded textures are skipped
+      *   @param loaded Handles of all ids are set here
+      *   @remark Called with mutex locked
+      */
+    void Load(const std::vector<Textures::ID>& ids, std::array<TextureHandle, Textures::id_end>& loaded);
+
+    std::string directory;
+    mutable std::mutex mutex; /**< Guards all members below */
+    std::array<std::weak_ptr<sf::Texture>, Textures::id_end> textures;
+    int decoded = 0;
+    int hits = 0;
+    int threads_used = 0; /**< Most decoding threads of one batch */
+    Clock::duration decode_time{}; /**< Wall time */
+    Clock::duration sequential_time{}; /**< Sum over the files */
+    Clock::duration upload_time{};
+};
@@ -25,7 +25,7 @@ class Base : public Entity {
    *   @param b bases body for collisions
    *   @param t bases texture
    *   @param position Place as vector where base is created
-   *   @param team Bases team
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Base(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position, Game::TEAM_ID team);
+  Base(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 };
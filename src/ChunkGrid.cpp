@@ -0,0 +1,193 @@
+/**
+  *   @file ChunkGrid.cpp
+  *   @brief Source code for class ChunkGrid
+  */
+
+#include "ChunkGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+/*  Member Initializations */
+const float ChunkGrid::CHUNK_WIDTH = Game::WIDTH / 4.f;
+const float ChunkGrid::ACTIVE_DISTANCE = Game::WIDTH;
+
+/*  Remove all chunks */
+void ChunkGrid::reset()
+{
+  chunks.clear();
+  chunk_active.clear();
+  always_active.clear();
+  active_entities.clear();
+  active_dirty = true;
+}
+
+int ChunkGrid::ChunkIndex(float x) const
+{
+  auto index = static_cast<int>(std::floor(x / CHUNK_WIDTH));
+  return std::max(0, std::min(index, static_cast<int>(chunks.size()) - 1));
+}
+
+/*  Add entity to chunk */
+void ChunkGrid::insert(Entity *entity)
+{
+  Game::TYPE_ID type = entity->getTypeId();
+  if (type == Game::TYPE_ID::ground || type == Game::TYPE_ID::invisible_wall || entity->getSize().x > CHUNK_WIDTH)
+  {
+    entity->setChunk(-1);
+    always_active.push_back(entity);
+  }
+  else
+  {
+    float x = entity->getB2Body()->GetPosition().x * Game::TOPIXELS;
+    auto chunk = static_cast<int>(std::max(0.f, std::floor(x / CHUNK_WIDTH)));
+    if (chunk >= static_cast<int>(chunks.size()))
+    {
+      // Level continues, bodies are created active
+      chunks.resize(chunk + 1);
+      chunk_active.resize(chunk + 1, true);
+    }
+    entity->setChunk(chunk);
+    chunks[chunk].push_back(entity);
+    if (! chunk_active[chunk])
+    {
+      entity->getB2Body()->SetActive(false);
+    }
+  }
+  active_dirty = true;
+}
+
+/*  Remove entity from chunk */
+void ChunkGrid::remove(Entity *entity)
+{
+  int chunk = entity->getChunk();
+  std::vector<Entity*> &container = chunk < 0 ? always_active : chunks[chunk];
+  auto it = std::find(container.begin(), container.end(), entity);
+  if (it != container.end())
+  {
+    // Order within a chunk doesn't matter
+    *it = container.back();
+    container.pop_back();
+    active_dirty = true;
+  }
+}
+
+/*  Relocate moved entities and update active chunks */
+void ChunkGrid::update(const std::vector<float> &focus_x)
+{
+  // Only entities in active chunks can move
+  for (int chunk = 0; chunk < static_cast<int>(chunks.size()); chunk++)
+  {
+    if (! chunk_active[chunk])
+    {
+      continue;
+    }
+    std::vector<Entity*> &container = chunks[chunk];
+    for (std::size_t i = 0; i < container.size(); )
+    {
+      Entity *entity = container[i];
+      int new_chunk = ChunkIndex(entity->getB2Body()->GetPosition().x * Game::TOPIXELS);
+      if (new_chunk == chunk)
+      {
+        i++;
+        continue;
+      }
+      container[i] = container.back();
+      container.pop_back();
+      chunks[new_chunk].push_back(entity);
+      entity->setChunk(new_chunk);
+      if (! chunk_active[new_chunk])
+      {
+        // Moved out of the active area
+        entity->getB2Body()->SetActive(false);
+        entity->erase_surroundings();
+      }
+      active_dirty = true;
+    }
+  }
+
+  if (focus_x.empty() || chunks.empty())
+  {
+    // Nobody to focus on (e.g. game over), keep the current state
+    CollectActive();
+    return;
+  }
+  // Chunks within ACTIVE_DISTANCE from any player plane are active
+  std::vector<bool> wanted(chunks.size(), false);
+  for (float x : focus_x)
+  {
+    int first = ChunkIndex(x - ACTIVE_DISTANCE);
+    int last = ChunkIndex(x + ACTIVE_DISTANCE);
+    std::fill(wanted.begin() + first, wanted.begin() + last + 1, true);
+  }
+  for (std::size_t chunk = 0; chunk < chunks.size(); chunk++)
+  {
+    if (wanted[chunk] != chunk_active[chunk])
+    {
+      SetChunkActive(chunk, wanted[chunk]);
+    }
+  }
+  CollectActive();
+}
+
+void ChunkGrid::SetChunkActive(int chunk, bool active)
+{
+  for (Entity *entity : chunks[chunk])
+  {
+    entity->getB2Body()->SetActive(active);
+    // Contacts of an inactive body are gone, don't let AI act on old ones
+    entity->erase_surroundings();
+  }
+  chunk_active[chunk] = active;
+  active_dirty = true;
+}
+
+void ChunkGrid::CollectActive()
+{
+  if (! active_dirty)
+  {
+    return;
+  }
+  active_entities.assign(always_active.begin(), always_active.end());
+  for (std::size_t chunk = 0; chunk < chunks.size(); chunk++)
+  {
+    if (chunk_active[chunk])
+    {
+      active_entities.insert(active_entities.end(), chunks[chunk].begin(), chunks[chunk].end());
+    }
+  }
+  active_dirty = false;
+}
+
+const std::vector<Entity*>& ChunkGrid::getActiveEntities()
+{
+  CollectActive();
+  return active_entities;
+}
+
+void ChunkGrid::collectVisible(float left, float right, std::vector<Entity*> &out) const
+{
+  out.assign(always_active.begin(), always_active.end());
+  if (chunks.empty())
+  {
+    return;
+  }
+  int first = ChunkIndex(left - CHUNK_WIDTH);
+  int last = ChunkIndex(right + CHUNK_WIDTH);
+  for (int chunk = first; chunk <= last; chunk++)
+  {
+    if (chunk_active[chunk])
+    {
+      out.insert(out.end(), chunks[chunk].begin(), chunks[chunk].end());
+    }
+  }
+}
+
+int ChunkGrid::getActiveChunkCount() const
+{
+  return static_cast<int>(std::count(chunk_active.begin(), chunk_active.end(), true));
+}
+
+int ChunkGrid::getChunkCount() const
+{
+  return static_cast<int>(chunks.size());
+}
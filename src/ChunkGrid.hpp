@@ -0,0 +1,110 @@
+/**
+  *   @file ChunkGrid.hpp
+  *   @brief Header for ChunkGrid class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "Entity.hpp"
+#include <vector>
+
+/**
+  *   @class ChunkGrid
+  *   @brief Splits the level into vertical chunks along the x-axis
+  *   @details Only chunks near the player planes are active. Bodies in inactive
+  *   chunks are deactivated in Box2D and skipped by the AI, so the per frame
+  *   cost depends on the area around the players, not on the level size.
+  *   Terrain (ground and invisible walls) spans many chunks and is always active.
+  *   @remark Player planes are not stored here, they are always active
+  */
+class ChunkGrid
+{
+  public:
+
+    static const float CHUNK_WIDTH; /**< Chunk width in pixels */
+    static const float ACTIVE_DISTANCE; /**< Chunks closer than this to a player plane are active (pixels) */
+
+    /**
+      *   @brief Remove all entities and chunks
+      *   @remark Chunks are created when entities are inserted
+      */
+    void reset();
+
+    /**
+      *   @brief Add entity to the chunk matching its position
+      *   @param entity Entity to be added, body must exist
+      */
+    void insert(Entity *entity);
+
+    /**
+      *   @brief Remove entity from its chunk
+      *   @param entity Entity to be removed
+      */
+    void remove(Entity *entity);
+
+    /**
+      *   @brief Move entities to new chunks and update active chunks
+      *   @details Entities that move to an inactive chunk are deactivated.
+      *   Bodies of chunks that become (in)active are (de)activated.
+      *   @param focus_x X-coordinates of the player planes (pixels), if empty
+      *   active chunks aren't changed
+      */
+    void update(const std::vector<float> &focus_x);
+
+    /**
+      *   @return Returns always active entities and entities in active chunks
+      *   @remark The container is rebuilt only after changes
+      */
+    const std::vector<Entity*>& getActiveEntities();
+
+    /**
+      *   @brief Collect entities that may be visible in an x-range
+      *   @details Always active entities and entities of the active chunks
+      *   overlapping the range. One chunk more is taken on both sides because
+      *   entities are sorted by their center.
+      *   @param left Left edge of the range (pixels)
+      *   @param right Right edge of the range (pixels)
+      *   @param out Cleared and filled with the entities
+      */
+    void collectVisible(float left, float right, std::vector<Entity*> &out) const;
+
+    /**
+      *   @return Returns the amount of active chunks
+      */
+    int getActiveChunkCount() const;
+
+    /**
+      *   @return Returns the amount of chunks
+      */
+    int getChunkCount() const;
+
+  private:
+
+    /**
+      *   @brief Get chunk index for x coordinate
+      *   @param x X-coordinate in pixels
+      *   @return Returns index clamped to the existing chunks
+      *   @remark Entities beyond the right most chunk stay in it
+      */
+    int ChunkIndex(float x) const;
+
+    /**
+      *   @brief Activate or deactivate all entities of a chunk
+      *   @param chunk Chunk index
+      *   @param active New state
+      */
+    void SetChunkActive(int chunk, bool active);
+
+    /**
+      *   @brief Rebuild active_entities
+      */
+    void CollectActive();
+
+    std::vector<std::vector<Entity*>> chunks; /**< Entities by chunk */
+    std::vector<bool> chunk_active; /**< Current state of each chunk */
+    std::vector<Entity*> always_active; /**< Terrain spanning over many chunks */
+    std::vector<Entity*> active_entities; /**< always_active and entities of active chunks */
+    bool active_dirty = true; /**< active_entities needs to be rebuilt */
+};
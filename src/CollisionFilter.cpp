@@ -0,0 +1,144 @@
+/**
+  *   @file CollisionFilter.cpp
+  *   @brief Collision matrix and its compilation to filter bits
+  */
+
+#include "CollisionFilter.hpp"
+#include <array>
+
+namespace
+{
+  /**
+    *   @enum Relation
+    *   @brief Which teams of a kind pair collide
+    */
+  enum Relation
+    {
+      any_team,
+      enemy_team
+    };
+
+  /**
+    *   @struct Rule
+    *   @brief One symmetric row of the collision matrix
+    */
+  struct Rule
+  {
+    Collision::Kind a;
+    Collision::Kind b;
+    Relation relation;
+  };
+
+  using namespace Collision;
+
+  // Pairs not listed here never create contacts. Static-static pairs are
+  // skipped by Box2D anyway.
+  const Rule MATRIX[] = {
+    { terrain, aircraft, any_team },        // planes crash to the ground
+    { terrain, ground_unit, any_team },     // infantry and anti aircraft stand on the ground
+    { terrain, projectile, any_team },      // bullets stop at the ground and walls
+    { scenery, aircraft, any_team },
+    { scenery, ground_unit, any_team },
+    { scenery, projectile, any_team },
+    { scenery, radar, any_team },           // AI targets rocks and trees
+    { aircraft, aircraft, any_team },
+    { aircraft, ground_unit, any_team },
+    { aircraft, structure, any_team },
+    { aircraft, projectile, any_team },
+    { aircraft, radar, any_team },
+    { aircraft, aa_radar, enemy_team },     // anti aircraft only shoots enemy planes
+    { ground_unit, ground_unit, any_team },
+    { ground_unit, structure, any_team },
+    { ground_unit, projectile, any_team },
+    { ground_unit, radar, any_team },
+    { structure, projectile, any_team },
+    { structure, radar, any_team },
+    { projectile, projectile, any_team },
+  };
+
+  /*  Kinds whose category depends on the team  */
+  bool HasTeams(Kind kind)
+  {
+    return kind == aircraft || kind == ground_unit || kind == structure || kind == aa_radar;
+  }
+
+  /*  Teams of kinds with teams: 0 blue, 1 red  */
+  int TeamIndex(Game::TEAM_ID team)
+  {
+    return team == Game::TEAM_ID::red ? 1 : 0;
+  }
+
+  /**
+    *   @brief Category bit of every (kind, team) pair
+    *   @details Kinds without teams use the same bit for both team slots
+    */
+  std::array<std::array<std::uint16_t, 2>, kind_end> BuildCategories()
+  {
+    std::array<std::array<std::uint16_t, 2>, kind_end> categories{};
+    int bit = 0;
+    for (int kind = 0; kind < kind_end; kind++)
+    {
+      categories[kind][0] = static_cast<std::uint16_t>(1u << bit++);
+      categories[kind][1] = HasTeams(static_cast<Kind>(kind)) ? static_cast<std::uint16_t>(1u << bit++) : categories[kind][0];
+    }
+    return categories;
+  }
+
+  /*  Compile the matrix to masks  */
+  std::array<std::array<std::uint16_t, 2>, kind_end> BuildMasks(const std::array<std::array<std::uint16_t, 2>, kind_end> &categories)
+  {
+    std::array<std::array<std::uint16_t, 2>, kind_end> masks{};
+    for (const Rule &rule : MATRIX)
+    {
+      for (int team_a = 0; team_a < 2; team_a++)
+      {
+        for (int team_b = 0; team_b < 2; team_b++)
+        {
+          if (rule.relation == enemy_team && team_a == team_b)
+          {
+            continue;
+          }
+          masks[rule.a][team_a] |= categories[rule.b][team_b];
+          masks[rule.b][team_b] |= categories[rule.a][team_a];
+        }
+      }
+    }
+    return masks;
+  }
+
+  const std::array<std::array<std::uint16_t, 2>, kind_end> CATEGORIES = BuildCategories();
+  const std::array<std::array<std::uint16_t, 2>, kind_end> MASKS = BuildMasks(CATEGORIES);
+}
+
+Collision::Bits Collision::getBits(Kind kind, Game::TEAM_ID team)
+{
+  int index = TeamIndex(team);
+  return { CATEGORIES[kind][index], MASKS[kind][index] };
+}
+
+bool Collision::collides(Bits a, Bits b)
+{
+  return (a.mask & b.category) != 0 && (b.mask & a.category) != 0;
+}
+
+Collision::Kind Collision::solidKind(Game::TYPE_ID type)
+{
+  switch (type)
+  {
+    case Game::TYPE_ID::airplane:
+      return aircraft;
+    case Game::TYPE_ID::antiaircraft:
+    case Game::TYPE_ID::infantry:
+      return ground_unit;
+    case Game::TYPE_ID::base:
+    case Game::TYPE_ID::hangar:
+      return structure;
+    case Game::TYPE_ID::bullet:
+      return projectile;
+    case Game::TYPE_ID::rock:
+    case Game::TYPE_ID::tree:
+      return scenery;
+    default:
+      return terrain;
+  }
+}
@@ -0,0 +1,71 @@
+/**
+  *   @file CollisionFilter.hpp
+  *   @brief Collision matrix compiled to Box2D category and mask bits
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include <cstdint>
+
+/**
+  *   @namespace Collision
+  *   @brief Declares which fixtures may create contacts
+  *   @details Each fixture has a kind and a team. The matrix in
+  *   CollisionFilter.cpp lists the kind pairs the game needs (for physics or
+  *   game logic), optionally only between enemies. Every (kind, team) pair gets
+  *   its own category bit and the matrix is compiled to mask bits, so Box2D
+  *   never creates the other contacts.
+  */
+namespace Collision
+{
+  /**
+    *   @enum Kind
+    *   @brief Fixture kinds of the collision matrix
+    */
+  enum Kind
+    {
+      terrain, /**< Merged ground and invisible walls */
+      scenery, /**< Rocks and trees */
+      aircraft,
+      ground_unit, /**< Infantry and anti aircraft */
+      structure, /**< Bases and hangars */
+      projectile,
+      radar, /**< AI sensor of planes and infantry, sees friends and enemies */
+      aa_radar, /**< Anti aircraft sensor, sees only enemy aircraft */
+      kind_end
+    };
+
+  /**
+    *   @struct Bits
+    *   @brief Box2D filter bits of one (kind, team) pair
+    */
+  struct Bits
+  {
+    std::uint16_t category;
+    std::uint16_t mask;
+  };
+
+  /**
+    *   @brief Get filter bits
+    *   @param kind Fixture kind
+    *   @param team Team of the owner, ignored for kinds without teams
+    *   @return Returns category and mask bits
+    */
+  Bits getBits(Kind kind, Game::TEAM_ID team = Game::TEAM_ID::all_friend);
+
+  /**
+    *   @brief Tell if two fixtures may create a contact
+    *   @return Returns true if both masks accept the other category
+    */
+  bool collides(Bits a, Bits b);
+
+  /**
+    *   @brief Get kind of the solid fixture of an entity
+    *   @param type Entity type
+    *   @return Returns matching kind
+    */
+  Kind solidKind(Game::TYPE_ID type);
+}
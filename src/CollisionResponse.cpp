@@ -0,0 +1,77 @@
+/**
+  *   @file CollisionResponse.cpp
+  *   @brief Contact rules and their compilation to the response matrix
+  */
+
+#include "CollisionResponse.hpp"
+#include "Entity.hpp"
+#include <array>
+
+namespace
+{
+  using namespace Collision;
+  using Game::TYPE_ID;
+
+  /**
+    *   @struct Rule
+    *   @brief Effect of a contact on both entities
+    */
+  struct Rule
+  {
+    TYPE_ID a;
+    TYPE_ID b;
+    Effect on_a;
+    Effect on_b;
+  };
+
+  const int PLANE_CRASH_DAMAGE = 10;
+
+  // Pairs not listed here don't affect each other
+  constexpr Rule RULES[] = {
+    { TYPE_ID::airplane, TYPE_ID::ground, { destroy, 0 }, { ignore, 0 } },      // planes crash to the ground
+    { TYPE_ID::airplane, TYPE_ID::airplane, { damage, PLANE_CRASH_DAMAGE }, { damage, PLANE_CRASH_DAMAGE } },
+    { TYPE_ID::airplane, TYPE_ID::infantry, { damage, PLANE_CRASH_DAMAGE }, { destroy, 0 } },  // planes run over infantry
+  };
+
+  using Matrix = std::array<std::array<Effect, TYPE_ID::type_id_end>, TYPE_ID::type_id_end>;
+
+  constexpr Matrix Compile()
+  {
+    Matrix matrix{};
+    for (auto& row : matrix)
+    {
+      for (auto& effect : row)
+      {
+        effect = { ignore, 0 };
+      }
+    }
+    for (const Rule& rule : RULES)
+    {
+      matrix[rule.a][rule.b] = rule.on_a;
+      matrix[rule.b][rule.a] = rule.on_b;
+    }
+    return matrix;
+  }
+
+  constexpr Matrix MATRIX = Compile();
+}
+
+const Effect& Collision::getEffect(Game::TYPE_ID self, Game::TYPE_ID other)
+{
+  return MATRIX[self][other];
+}
+
+bool Collision::ignore(Entity& /*self*/, int /*amount*/)
+{
+  return false;
+}
+
+bool Collision::destroy(Entity& /*self*/, int /*amount*/)
+{
+  return true;
+}
+
+bool Collision::damage(Entity& self, int amount)
+{
+  return self.damage(amount);
+}
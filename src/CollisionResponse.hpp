@@ -0,0 +1,64 @@
+/**
+  *   @file CollisionResponse.hpp
+  *   @brief Response matrix of solid contacts between entity types
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+
+class Entity;
+
+/**
+  *   @namespace Collision
+  *   @brief Declares what touching entities do to each other
+  *   @details The rules in CollisionResponse.cpp are compiled to a matrix
+  *   indexed by (Game::TYPE_ID, Game::TYPE_ID) when the program is compiled.
+  *   Resolving a contact is two table lookups and two handler calls, new unit
+  *   types only need new rules.
+  */
+namespace Collision
+{
+  /**
+    *   @brief Contact handler
+    *   @param self Entity the contact affects
+    *   @param amount Damage value of the rule
+    *   @return Returns true if the entity is destroyed
+    */
+  using Handler = bool (*)(Entity& self, int amount);
+
+  /**
+    *   @struct Effect
+    *   @brief Effect of a contact on one entity
+    */
+  struct Effect
+  {
+    Handler handler;
+    int amount; /**< Damage passed to the handler */
+  };
+
+  /**
+    *   @brief Get effect of a contact
+    *   @param self Type of the affected entity
+    *   @param other Type of the entity it touches
+    *   @return Returns effect on self, it does nothing if no rule matches
+    */
+  const Effect& getEffect(Game::TYPE_ID self, Game::TYPE_ID other);
+
+  /**
+    *   @brief Handler that leaves the entity as it is
+    */
+  bool ignore(Entity& self, int amount);
+
+  /**
+    *   @brief Handler that destroys the entity
+    */
+  bool destroy(Entity& self, int amount);
+
+  /**
+    *   @brief Handler that takes amount hit points from the entity
+    */
+  bool damage(Entity& self, int amount);
+}
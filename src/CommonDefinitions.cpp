@@ -65,6 +65,19 @@ namespace Game
 
 } // namespace Game
 
+namespace Weapons
+{
+  // Projectiles are sized as the bullet sprite (8x8), not as the shooter
+  const ProjectileSpec Projectiles[weapon_id_end] =
+    {
+      // width, height, impulse, gravity scale, damage, fire interval, muzzle offset, blast radius
+      { 8.f, 8.f, 1000.f, 0.5f, 10, 0.5f, 5.f, 0.f },  // plane_gun
+      { 8.f, 8.f, 1000.f, 0.5f, 10, 0.5f, 2.f, 0.f },  // anti_aircraft_gun
+      { 6.f, 6.f, 50.f, 0.f, 10, 1.f, 2.f, 0.f },      // infantry_rifle
+      { 10.f, 10.f, 0.f, 1.f, 20, 1.f, 2.f, 40.f },    // bomb, falls with the speed of the plane
+    };
+} // namespace Weapons
+
 namespace Paths
 {
 std::vector<std::string> Paths
@@ -117,7 +130,7 @@ std::vector<std::string> TextureFiles {
       "InvisibleWall_alpha.png"
 };
 
-  std::map<std::string, Textures::ID> alphaTextures
+  std::map<std::string, Textures::ID, std::less<>> alphaTextures
 {
   { "BlueAirplane", BlueAirplane_alpha },
   { "BlueAntiAircraft", BlueAntiAircraft_alpha },
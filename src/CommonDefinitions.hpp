@@ -56,7 +56,7 @@ namespace Textures
       id_end
     };
   extern std::vector<std::string> TextureFiles;
-  extern std::map<std::string, Textures::ID> alphaTextures;
+  extern std::map<std::string, Textures::ID, std::less<>> alphaTextures;
 }
 
 /**
@@ -153,6 +153,42 @@ namespace Game
   };
 }
 
+/**
+  *   @namespace Weapons
+  *   @brief Projectile specs shared by all weapon classes
+  */
+namespace Weapons
+{
+  enum ID
+    {
+      plane_gun,
+      anti_aircraft_gun,
+      infantry_rifle,
+      bomb,
+      weapon_id_end
+    };
+
+  /**
+    *   @struct ProjectileSpec
+    *   @brief Projectile and fire rate of one weapon
+    *   @remark Projectiles weigh 1 kg like the old bullet bodies, so impulse
+    *   equals the muzzle speed in m/s
+    */
+  struct ProjectileSpec
+  {
+    float width; /**< Projectile fixture width in pixels */
+    float height; /**< Projectile fixture height in pixels */
+    float impulse; /**< Impulse given to the projectile */
+    float gravity_scale; /**< Box2D gravity scale of the projectile */
+    int damage; /**< Hit points taken from the target */
+    float fire_interval; /**< Seconds between shots */
+    float muzzle_offset; /**< Pixels between the shooter and the new projectile */
+    float blast_radius; /**< Splash damage radius in pixels, 0 damages only the hit entity */
+  };
+
+  extern const ProjectileSpec Projectiles[weapon_id_end]; /**< Spec of each weapon, indexed by ID */
+}
+
 /**
   *   @namespace Paths
   *   @brief Contains the most important paths within air combat directory
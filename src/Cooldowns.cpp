@@ -0,0 +1,68 @@
+/**
+  *   @file Cooldowns.cpp
+  *   @brief Source code for class Cooldowns
+  */
+
+#include "Cooldowns.hpp"
+#include <cmath>
+
+/*  Member Initializations */
+const int Cooldowns::TICKS_PER_SECOND = 60;
+
+unsigned long Cooldowns::toTicks(float seconds)
+{
+  return seconds > 0 ? static_cast<unsigned long>(std::lround(seconds * TICKS_PER_SECOND)) : 0;
+}
+
+int Cooldowns::acquire()
+{
+  if (! free_slots.empty())
+  {
+    int slot = free_slots.back();
+    free_slots.pop_back();
+    ready_at[slot] = now;
+    return slot;
+  }
+  ready_at.push_back(now);
+  return static_cast<int>(ready_at.size()) - 1;
+}
+
+void Cooldowns::release(int slot)
+{
+  if (slot >= 0)
+  {
+    free_slots.push_back(slot);
+  }
+}
+
+void Cooldowns::reset()
+{
+  now = 0;
+  ready_at.clear();
+  free_slots.clear();
+}
+
+void Cooldowns::advance(unsigned long ticks)
+{
+  now += ticks;
+}
+
+bool Cooldowns::ready(int slot) const
+{
+  return now >= ready_at[slot];
+}
+
+void Cooldowns::start(int slot, unsigned long ticks)
+{
+  ready_at[slot] = now + ticks;
+}
+
+unsigned long Cooldowns::getTick() const
+{
+  return now;
+}
+
+std::size_t Cooldowns::size() const
+{
+  return ready_at.size() - free_slots.size();
+}
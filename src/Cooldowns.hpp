@@ -0,0 +1,86 @@
+/**
+  *   @file Cooldowns.hpp
+  *   @brief Header for Cooldowns class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include <cstddef>
+#include <vector>
+
+/**
+  *   @class Cooldowns
+  *   @brief Tick based cooldown timers of the world
+  *   @details Every entity owns a slot that holds the tick when it may act
+  *   again. The world advances the tick counter once per update, so checking
+  *   a cooldown is an integer compare and expired cooldowns need no work.
+  *   Time follows the simulation, not the wall clock, so fast-forward and
+  *   headless stepping give the same results as real time play.
+  */
+class Cooldowns
+{
+  public:
+
+    static const int TICKS_PER_SECOND; /**< World updates per simulated second */
+
+    /**
+      *   @brief Convert seconds to ticks
+      *   @param seconds Duration in simulated seconds
+      *   @return Returns the duration in ticks, rounded to the nearest tick
+      */
+    static unsigned long toTicks(float seconds);
+
+    /**
+      *   @brief Reserve a slot, the cooldown of a new slot is over
+      *   @return Returns the slot index
+      */
+    int acquire();
+
+    /**
+      *   @brief Return a slot for reuse
+      *   @param slot Slot returned by acquire, negative values are ignored
+      */
+    void release(int slot);
+
+    /**
+      *   @brief Release all slots and restart from tick 0
+      */
+    void reset();
+
+    /**
+      *   @brief Advance time
+      *   @param ticks Amount of ticks passed
+      */
+    void advance(unsigned long ticks = 1);
+
+    /**
+      *   @param slot Slot index
+      *   @return Returns true if the cooldown of the slot is over
+      */
+    bool ready(int slot) const;
+
+    /**
+      *   @brief Start cooldown
+      *   @param slot Slot index
+      *   @param ticks Cooldown length in ticks
+      */
+    void start(int slot, unsigned long ticks);
+
+    /**
+      *   @return Returns the current tick
+      */
+    unsigned long getTick() const;
+
+    /**
+      *   @return Returns the amount of slots in use
+      */
+    std::size_t size() const;
+
+  private:
+
+    unsigned long now = 0;
+    std::vector<unsigned long> ready_at; /**< Tick when the slot is ready, one per slot */
+    std::vector<int> free_slots; /**< Released slots */
+};
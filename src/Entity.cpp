@@ -1,24 +1,40 @@
 #include "Entity.hpp"
+#include "ProjectileSystem.hpp"
+#include "ParticleSystem.hpp"
+#include "Cooldowns.hpp"
 #include <assert.h>
 #include <iostream>
 
-Entity::Entity(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, float speed, int bullets, int bombs, int firerate, int hp, sf::Vector2f direct, Game::TEAM_ID team) : moveSpeed(speed), numberOfBullets(bullets), numberOfBombs(bombs), rateOfFire(firerate), fireCountDown(0), hitPoints(hp), direction(direct), teamId(team), world(w), b2body(b)
+Entity::Entity(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype) : moveSpeed(prototype.speed), numberOfBullets(prototype.bullets), numberOfBombs(prototype.bombs), hitPoints(prototype.hit_points), direction(1.0f, 0.0f), teamId(prototype.team), typeId(prototype.type), world(w), b2body(b), type(prototype.texture)
 {
   entity.setOrigin(sf::Vector2f(t.getSize().x, t.getSize().y) / 2.f);
   entity.setTexture(t);
   entity.setPosition(position);
+  storePreviousTransform();
 }
 
-/*Entity::~Entity()
-{
-  owner = nullptr;
-}*/
-
 void Entity::drawTo(sf::RenderWindow &window)
 {
   window.draw(entity);
 }
 
+SpriteState Entity::getSpriteState() const
+{
+  return SpriteState{type, entity.getTextureRect(), entity.getOrigin(), entity.getScale(),
+                     previous_position, entity.getPosition(), previous_rotation, entity.getRotation()};
+}
+
+void Entity::storePreviousTransform()
+{
+  previous_position = entity.getPosition();
+  previous_rotation = entity.getRotation();
+}
+
+sf::Vector2f Entity::getRenderPosition(float alpha) const
+{
+  return previous_position + (entity.getPosition() - previous_position) * alpha;
+}
+
 // Does not move by default
 void Entity::moveUp(){}
 
@@ -65,7 +81,8 @@ sf::Vector2f Entity::getOriginPosition() const {
 
 void Entity::setPos(sf::Vector2f newPos)
 {
-  assert (newPos.x >= 0 && newPos.x <= Game::WIDTH);
+  // Levels can be wider than the window, the level width isn't known here
+  assert (newPos.x >= 0);
   assert (newPos.y >= 0 && newPos.y <= Game::HEIGHT);
   entity.setPosition(newPos);
 }
@@ -93,14 +110,17 @@ void Entity::move(sf::Vector2f direction){
   setPos(getPosition() + moveSpeed*direction);
 }
 
-bool Entity::shoot(sf::Vector2f direction, ResourceManager& resources) {
+bool Entity::shoot(sf::Vector2f direction) {
 
   (void) direction;
-  (void) resources;
   return false;
 
 }
 
+bool Entity::dropBomb() {
+  return false;
+}
+
 void Entity::setType(Textures::ID t){
   type = t;
 }
@@ -109,6 +129,36 @@ Textures::ID Entity::getType() {return type;}
 
 b2Body* Entity::getB2Body() {return b2body;}
 
+bool Entity::fireProjectile(Weapons::ID weapon, sf::Vector2f position, sf::Vector2f direction) {
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[weapon];
+  if (projectiles == nullptr || cooldowns == nullptr) {
+    return false;
+  }
+  int& ammunition = (weapon == Weapons::bomb) ? numberOfBombs : numberOfBullets;
+  if (! cooldowns->ready(cooldown) || ammunition <= 0) {
+    return false;
+  }
+  ammunition -= 1;
+
+  // projectiles weigh 1 kg, the impulse gives the start speed
+  b2Vec2 velocity(direction.x*spec.impulse, direction.y*spec.impulse);
+  if (weapon == Weapons::bomb) {
+    velocity += b2body->GetLinearVelocity();
+  }
+  projectiles->spawn(weapon, b2Vec2(position.x*Game::TOMETERS, position.y*Game::TOMETERS), velocity, this, getCollisionGroup());
+  if (particles != nullptr && weapon != Weapons::bomb) {
+    particles->emit(ParticleSystem::muzzle_flash, position, direction);
+  }
+
+  cooldowns->start(cooldown, Cooldowns::toTicks(spec.fire_interval));
+  return true;
+}
+
+int16 Entity::getCollisionGroup() {
+  b2Fixture* fixture = b2body->GetFixtureList();
+  return fixture != nullptr ? fixture->GetFilterData().groupIndex : 0;
+}
+
 bool Entity::setScale(float width, float height) {
   if (width > 0) {
     if (height > 0) {
@@ -141,8 +191,10 @@ Game::TYPE_ID Entity::getTypeId(){
 
 bool Entity::damage(int damage){
 
+  // A target already dead may be hit again in the same tick, it dies once
+  bool alive = hitPoints > 0;
   hitPoints -= damage;
-  return hitPoints <= 0;
+  return alive && hitPoints <= 0;
 }
 
 void Entity::insert_surrounding(Entity* entity) {
@@ -157,13 +209,59 @@ std::list<Entity*>& Entity::get_surroundings() {
   return surrounding;
 }
 
-std::list<std::shared_ptr<Entity>>& Entity::get_active_bullets() {
-  return active_bullets;
+void Entity::setProjectileSystem(ProjectileSystem* system) {
+  projectiles = system;
+}
+
+void Entity::setParticleSystem(ParticleSystem* system) {
+  particles = system;
+}
+
+void Entity::setCooldown(Cooldowns* timers, int slot) {
+  cooldowns = timers;
+  cooldown = slot;
+}
+
+int Entity::getCooldown() const {
+  return cooldown;
+}
+
+Entity::State Entity::getState() const
+{
+  return { entity.getPosition(), entity.getScale(), entity.getTextureRect(), direction,
+           hitPoints, numberOfBullets, numberOfBombs };
+}
+
+void Entity::setState(const State& state)
+{
+  entity.setPosition(state.position);
+  storePreviousTransform();
+  entity.setScale(state.scale);
+  entity.setTextureRect(state.texture_rect);
+  direction = state.direction;
+  hitPoints = state.hit_points;
+  numberOfBullets = state.bullets;
+  numberOfBombs = state.bombs;
+}
+
+int Entity::getChunk() const
+{
+  return chunk;
+}
+
+void Entity::setChunk(int chunk_index)
+{
+  chunk = chunk_index;
+}
+
+int Entity::getMinimapCell() const
+{
+  return minimap_cell;
 }
 
-Entity* Entity::getOwner()
+void Entity::setMinimapCell(int cell_index)
 {
-  return owner;
+  minimap_cell = cell_index;
 }
 
 bool Entity::getFacing()
@@ -7,11 +7,17 @@
 /* Includes */
 #include "CommonDefinitions.hpp"
 #include "ResourceManager.hpp"
+#include "UnitPrototypes.hpp"
+#include "RenderFrame.hpp"
 #include <iostream>
 #include <SFML/Graphics.hpp>
 #include <Box2D/Box2D.h>
 #include <list>
 
+class ProjectileSystem;
+class ParticleSystem;
+class Cooldowns;
+
 /**
   *   @class Entity
   *   @brief Base Class for all Entities
@@ -21,21 +27,32 @@
 class Entity {
 public:
 
+  /**
+    *   @struct State
+    *   @brief Sprite and game state of an Entity, used by WorldSnapshot
+    */
+  struct State
+  {
+    sf::Vector2f position; /**< Sprite position */
+    sf::Vector2f scale; /**< Sprite scale */
+    sf::IntRect texture_rect; /**< Sprite texture rect, tells the facing */
+    sf::Vector2f direction; /**< Movement direction */
+    int hit_points;
+    int bullets;
+    int bombs;
+  };
+
   /**
    *   @brief Construct a Entity object.
+   *   @details Stats, team and type are copied from the prototype, the entity
+   *   moves right at first
    *   @param w Gameworld where entity is created in
    *   @param b Entitys body for collisions
    *   @param t Entitys texture
    *   @param position Place as vector where entity is created
-   *   @param speed Maximum speed for entity
-   *   @param bullets Number of bullets this entity can shoot
-   *   @param bombs Number of bombs this entity can drop
-   *   @param firerate How many frames does it take for the entity to shoot again, so 60 would mean shooting once per second.
-   *   @param hp Hitpoint of this entity
-   *   @param direct Direction where entity is moving
-   *   @param team The team entity belongs to: blue, red, obstacle or projectile
+   *   @param prototype Unit prototype of the entity, see UnitPrototypes.cpp
    */
-  Entity(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position,  float speed, int bullets, int bombs, int firerate, int hp, sf::Vector2f direct, Game::TEAM_ID team);
+  Entity(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 
   //virtual ~Entity();
   /**
@@ -44,6 +61,24 @@ public:
    */
   void drawTo(sf::RenderWindow &window);
 
+  /**
+   *   @return Returns the sprite of the last two steps for the render thread
+   */
+  SpriteState getSpriteState() const;
+
+  /**
+   *   @brief Start interpolation from the current transform
+   *   @details Called before the sprite is moved to the new body position,
+   *   and after a teleport so that nothing is interpolated
+   */
+  void storePreviousTransform();
+
+  /**
+   *   @param alpha Fraction of a step since the last step, 0...1
+   *   @return Returns the drawn position between the last two steps
+   */
+  sf::Vector2f getRenderPosition(float alpha) const;
+
   /*
    *   @brief Move entity
    *   @param Distance Direction as vector where to move entity
@@ -126,7 +161,13 @@ public:
   /*
    *   @brief General shoot function for entity, more defined version in subclasses
    */
-  virtual bool shoot(sf::Vector2f direction, ResourceManager& resources);
+  virtual bool shoot(sf::Vector2f direction);
+
+  /**
+   *   @brief Drop a bomb, entities without bombs do nothing
+   *   @return Returns true if a bomb was dropped
+   */
+  virtual bool dropBomb();
 
   /*
    *   @brief Gives a type for entity
@@ -145,6 +186,12 @@ public:
    */
   b2Body* getB2Body();
 
+  /**
+   *   @brief Get collision group of the body
+   *   @return Returns group index of the body fixtures, 0 if there is no group
+   */
+  int16 getCollisionGroup();
+
   /*
    *   @brief Scales a picture bigger or smaller
    *   @param width of map
@@ -167,7 +214,8 @@ public:
 
   /*
    *   @brief Activated when entity is damaged
-   *   @return True is damage kills the entity, False if entity only loses hitpoints
+   *   @return True if this damage kills the entity, False if entity only
+   *   loses hitpoints or was already dead
    *   @param damage Amount of damage to entity
    */
   bool damage(int damage);
@@ -220,25 +268,87 @@ public:
    */
   void faceRight();
 
-  /**
-    *   @brief Get owner entity
-    *   @return Returns raw pointer to of the owner, or nullptr
-    */
-  Entity* getOwner();
-
   /**
     *   @brief Get facing of the entity
     *   @return Return true if facing right, else false
     */
   bool getFacing();
 
-  /*
-   *   @brief Returns active bullets of this entity
-   */
-  std::list<std::shared_ptr<Entity>>& get_active_bullets();
-  sf::Clock clock;
+  /**
+    *   @brief Get sprite and game state
+    *   @return Returns current State
+    */
+  State getState() const;
+
+  /**
+    *   @brief Restore sprite and game state
+    *   @param state State returned by getState
+    */
+  void setState(const State& state);
+
+  /**
+    *   @brief Get chunk index
+    *   @return Returns ChunkGrid chunk index, -1 if the entity isn't in a chunk
+    */
+  int getChunk() const;
+
+  /**
+    *   @brief Set chunk index, used by ChunkGrid
+    *   @param chunk_index New chunk index
+    */
+  void setChunk(int chunk_index);
+
+  /**
+    *   @brief Get minimap cell
+    *   @return Returns Minimap cell index, -1 if the entity isn't counted
+    */
+  int getMinimapCell() const;
+
+  /**
+    *   @brief Set minimap cell, used by World
+    *   @param cell_index Cell returned by Minimap
+    */
+  void setMinimapCell(int cell_index);
+
+  /**
+    *   @brief Set the system the entity fires its projectiles to
+    *   @param system Projectile system of the world
+    */
+  void setProjectileSystem(ProjectileSystem* system);
+
+  /**
+    *   @brief Set the system muzzle flashes are emitted to
+    *   @param system Particle system of the world
+    */
+  void setParticleSystem(ParticleSystem* system);
+
+  /**
+    *   @brief Set the fire rate cooldown of the entity
+    *   @param timers Cooldowns of the world
+    *   @param slot Slot reserved for the entity
+    */
+  void setCooldown(Cooldowns* timers, int slot);
+
+  /**
+    *   @return Returns the cooldown slot of the entity, -1 if there is none
+    */
+  int getCooldown() const;
+
 protected:
 
+  /**
+   *   @brief Fire one projectile of a weapon
+   *   @details Checks fire rate cooldown and ammunition left and spawns the
+   *   projectile of the weapon's ProjectileSpec to the projectile system.
+   *   Bombs use numberOfBombs and keep the speed of the entity. Guns emit a
+   *   muzzle flash.
+   *   @param weapon Weapon whose spec is used
+   *   @param position Projectile center in pixels
+   *   @param direction Unit vector of the shot
+   *   @return Returns true if the projectile was fired
+   */
+  bool fireProjectile(Weapons::ID weapon, sf::Vector2f position, sf::Vector2f direction);
+
     /*  Variables */
 
   //sf::RectangleShape entity;
@@ -246,8 +356,6 @@ protected:
   float moveSpeed; /**< Entitys speed */
   int numberOfBullets; /**< Number of bullets entity has left */
   int numberOfBombs; /**< Number of bombs entity has left */
-  int rateOfFire; /**< Number of frames that must pass until entity is able to fire again */
-  int fireCountDown; /**< Value set to rateOfFire when entity shoots, every frame value drops by 1, when value 0 or lower, entity can fire */
   int hitPoints; /**< Hitpoints of entity, if they are zero or lower entity is destroyed */
   sf::Vector2f direction; /**< Diretion of entitys movement */
   Game::TEAM_ID teamId; /**< Tells if entity is in blue or red team, obstacle or projetile */
@@ -258,6 +366,12 @@ protected:
   b2Body* b2body; /**< Entitys body */
   Textures::ID type; /**< Textures file name without extension */
   std::list<Entity*> surrounding;
-  std::list<std::shared_ptr<Entity>> active_bullets;
-  Entity *owner = nullptr; /**< Possible owner entity for Bullets */
+  ProjectileSystem* projectiles = nullptr; /**< Fired projectiles are spawned here */
+  ParticleSystem* particles = nullptr; /**< Muzzle flashes are emitted here */
+  Cooldowns* cooldowns = nullptr; /**< Tick based timers of the world */
+  int cooldown = -1; /**< Fire rate slot in cooldowns */
+  int chunk = -1; /**< ChunkGrid chunk where the entity is stored */
+  int minimap_cell = -1; /**< Minimap cell where the entity is counted */
+  sf::Vector2f previous_position; /**< Sprite position before the last step */
+  float previous_rotation = 0; /**< Sprite rotation before the last step */
 };
@@ -0,0 +1,34 @@
+/**
+  *   @file EntityCounters.cpp
+  *   @brief Source code for class EntityCounters
+  */
+
+#include "EntityCounters.hpp"
+
+void EntityCounters::add(Game::TEAM_ID team, Game::TYPE_ID type)
+{
+  live[team][type]++;
+  team_live[team]++;
+}
+
+void EntityCounters::remove(Game::TEAM_ID team, Game::TYPE_ID type)
+{
+  live[team][type]--;
+  team_live[team]--;
+}
+
+void EntityCounters::reset()
+{
+  live = {};
+  team_live = {};
+}
+
+int EntityCounters::count(Game::TEAM_ID team, Game::TYPE_ID type) const
+{
+  return live[team][type];
+}
+
+int EntityCounters::count(Game::TEAM_ID team) const
+{
+  return team_live[team];
+}
@@ -0,0 +1,52 @@
+/**
+  *   @file EntityCounters.hpp
+  *   @brief Header for EntityCounters class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include <array>
+
+/**
+  *   @class EntityCounters
+  *   @brief Live entities per team and type
+  *   @details World updates the counters when entities are created and
+  *   removed, so win checks don't have to scan the entities.
+  */
+class EntityCounters
+{
+  public:
+
+    /**
+      *   @brief Count a new entity
+      */
+    void add(Game::TEAM_ID team, Game::TYPE_ID type);
+
+    /**
+      *   @brief Uncount a removed entity
+      */
+    void remove(Game::TEAM_ID team, Game::TYPE_ID type);
+
+    /**
+      *   @brief Set all counters to zero
+      */
+    void reset();
+
+    /**
+      *   @return Returns the amount of live entities of the team and type
+      */
+    int count(Game::TEAM_ID team, Game::TYPE_ID type) const;
+
+    /**
+      *   @return Returns the amount of live entities of the team
+      */
+    int count(Game::TEAM_ID team) const;
+
+  private:
+
+    std::array<std::array<int, Game::TYPE_ID::type_id_end>, Game::TEAM_ID::team_id_end> live{};
+    std::array<int, Game::TEAM_ID::team_id_end> team_live{};
+};
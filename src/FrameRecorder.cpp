@@ -0,0 +1,214 @@
+/**
+  *   @file FrameRecorder.cpp
+  *   @brief Source code for class FrameRecorder
+  */
+
+#include "FrameRecorder.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <experimental/filesystem>
+#include <iostream>
+
+/*  Member Initializations */
+const std::size_t FrameRecorder::DEFAULT_RING_SIZE = 8;
+const unsigned FrameRecorder::DEFAULT_WORKERS = 2;
+
+FrameRecorder::FrameRecorder(const std::string& directory, Format format, unsigned width, unsigned height,
+                             std::size_t ring_size, unsigned workers)
+  : directory(directory), format(format), width(width), height(height), ring(std::max<std::size_t>(ring_size, 1))
+{
+  std::error_code error;
+  std::experimental::filesystem::create_directories(directory, error);
+  if (format == yuv_stream)
+  {
+    stream.open(directory + "/capture.yuv", std::ios::binary | std::ios::trunc);
+    open = stream.is_open();
+  }
+  else
+  {
+    open = std::experimental::filesystem::is_directory(directory, error);
+  }
+  if (! open)
+  {
+    std::cout << "Recording to " << directory << " failed" << std::endl;
+  }
+
+  // Whole ring is allocated here, submit only copies
+  for (std::size_t i = 0; i < ring.size(); i++)
+  {
+    ring[i].pixels.resize(static_cast<std::size_t>(width) * height * 4);
+    free_slots.push_back(i);
+  }
+  for (unsigned i = 0; i < std::max(workers, 1u); i++)
+  {
+    this->workers.emplace_back(&FrameRecorder::Work, this);
+  }
+}
+
+FrameRecorder::~FrameRecorder()
+{
+  finish();
+}
+
+bool FrameRecorder::isOpen() const
+{
+  return open;
+}
+
+sf::Vector2u FrameRecorder::getSize() const
+{
+  return sf::Vector2u(width, height);
+}
+
+bool FrameRecorder::submit(const sf::Uint8* pixels)
+{
+  std::size_t index;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (! open || finishing || free_slots.empty())
+    {
+      dropped++;
+      return false;
+    }
+    index = free_slots.back();
+    free_slots.pop_back();
+    ring[index].frame = next_frame++;
+  }
+  // Slot belongs to this thread until it is queued
+  std::memcpy(ring[index].pixels.data(), pixels, ring[index].pixels.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queued.push_back(index);
+  }
+  work.notify_one();
+  return true;
+}
+
+void FrameRecorder::finish()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (finishing)
+    {
+      return;
+    }
+    finishing = true;
+  }
+  work.notify_all();
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+  workers.clear();
+  if (stream.is_open())
+  {
+    stream.close();
+  }
+}
+
+long FrameRecorder::getCapturedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return next_frame;
+}
+
+long FrameRecorder::getDroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return dropped;
+}
+
+long FrameRecorder::getEncodedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return encoded_frames;
+}
+
+void FrameRecorder::Work()
+{
+  while (true)
+  {
+    std::size_t index;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      work.wait(lock, [this] { return finishing || ! queued.empty(); });
+      if (queued.empty())
+      {
+        // Finishing and nothing left
+        return;
+      }
+      index = queued.front();
+      queued.pop_front();
+    }
+    Encode(ring[index]);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      free_slots.push_back(index);
+      encoded_frames++;
+    }
+  }
+}
+
+void FrameRecorder::Encode(Slot& slot)
+{
+  if (format == png_sequence)
+  {
+    char name[32];
+    std::snprintf(name, sizeof name, "/frame_%06ld.png", slot.frame);
+    sf::Image image;
+    image.create(width, height, slot.pixels.data());
+    image.saveToFile(directory + name);
+    return;
+  }
+
+  // Conversion runs in parallel, writing in frame order
+  convertToI420(slot.pixels.data(), width, height, slot.encoded);
+  std::unique_lock<std::mutex> lock(write_mutex);
+  write_turn.wait(lock, [this, &slot] { return next_write == slot.frame; });
+  stream.write(reinterpret_cast<const char*>(slot.encoded.data()), slot.encoded.size());
+  next_write++;
+  lock.unlock();
+  write_turn.notify_all();
+}
+
+void FrameRecorder::convertToI420(const sf::Uint8* rgba, unsigned width, unsigned height, std::vector<sf::Uint8>& yuv)
+{
+  const std::size_t chroma_width = (width + 1) / 2;
+  const std::size_t chroma_height = (height + 1) / 2;
+  const std::size_t luma_size = static_cast<std::size_t>(width) * height;
+  yuv.resize(luma_size + 2 * chroma_width * chroma_height);
+  sf::Uint8* y_plane = yuv.data();
+  sf::Uint8* u_plane = y_plane + luma_size;
+  sf::Uint8* v_plane = u_plane + chroma_width * chroma_height;
+
+  for (std::size_t i = 0; i < luma_size; i++)
+  {
+    const sf::Uint8* pixel = rgba + i * 4;
+    y_plane[i] = static_cast<sf::Uint8>(((66 * pixel[0] + 129 * pixel[1] + 25 * pixel[2] + 128) >> 8) + 16);
+  }
+  // Chroma of the average of each 2x2 block
+  for (std::size_t cy = 0; cy < chroma_height; cy++)
+  {
+    for (std::size_t cx = 0; cx < chroma_width; cx++)
+    {
+      int r = 0, g = 0, b = 0, n = 0;
+      for (std::size_t y = cy * 2; y < std::min<std::size_t>(cy * 2 + 2, height); y++)
+      {
+        for (std::size_t x = cx * 2; x < std::min<std::size_t>(cx * 2 + 2, width); x++)
+        {
+          const sf::Uint8* pixel = rgba + (y * width + x) * 4;
+          r += pixel[0];
+          g += pixel[1];
+          b += pixel[2];
+          n++;
+        }
+      }
+      r /= n;
+      g /= n;
+      b /= n;
+      u_plane[cy * chroma_width + cx] = static_cast<sf::Uint8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      v_plane[cy * chroma_width + cx] = static_cast<sf::Uint8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  }
+}
@@ -0,0 +1,162 @@
+/**
+  *   @file FrameRecorder.hpp
+  *   @brief Header for FrameRecorder class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+  *   @class FrameRecorder
+  *   @brief Encodes captured frames to files on worker threads
+  *   @details Captured pixels are copied to a ring of preallocated staging
+  *   buffers and the caller returns at once. Worker threads encode the
+  *   buffers and give them back to the ring. If every buffer is still being
+  *   encoded the frame is dropped instead of waiting, so recording never
+  *   stalls the thread that captures.
+  *   The PNG sequence writes frame_000000.png, frame_000001.png, ... in any
+  *   order. The YUV stream writes every frame as planar 8-bit I420 (BT.601,
+  *   limited range) to capture.yuv in frame order, e.g.
+  *   ffmpeg -f rawvideo -pix_fmt yuv420p -s 800x600 -r 60 -i capture.yuv out.mp4
+  */
+class FrameRecorder
+{
+  public:
+
+    /**
+      *   @brief Output formats
+      */
+    enum Format
+    {
+      png_sequence, /**< One PNG file per frame */
+      yuv_stream /**< Raw I420 frames in one file */
+    };
+
+    static const std::size_t DEFAULT_RING_SIZE; /**< Staging buffers */
+    static const unsigned DEFAULT_WORKERS; /**< Encoding threads */
+
+    /**
+      *   @brief Constructor, creates the directory and starts the workers
+      *   @param directory Output directory
+      *   @param format Output format
+      *   @param width Frame width in pixels
+      *   @param height Frame height in pixels
+      *   @param ring_size Staging buffers, frames queued for encoding at most
+      *   @param workers Encoding threads
+      */
+    FrameRecorder(const std::string& directory, Format format, unsigned width, unsigned height,
+                  std::size_t ring_size = DEFAULT_RING_SIZE, unsigned workers = DEFAULT_WORKERS);
+
+    /**
+      *   @brief Destructor, encodes the queued frames
+      */
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /**
+      *   @return Returns false if the output couldn't be created
+      */
+    bool isOpen() const;
+
+    /**
+      *   @return Returns the frame size in pixels
+      */
+    sf::Vector2u getSize() const;
+
+    /**
+      *   @brief Queue a frame for encoding
+      *   @param pixels RGBA pixels, width * height * 4 bytes
+      *   @return Returns false if the frame was dropped
+      */
+    bool submit(const sf::Uint8* pixels);
+
+    /**
+      *   @brief Encode the queued frames and stop the workers
+      *   @details Later frames are dropped
+      */
+    void finish();
+
+    /**
+      *   @return Returns the amount of frames queued for encoding
+      */
+    long getCapturedCount() const;
+
+    /**
+      *   @return Returns the amount of frames dropped because the ring was full
+      */
+    long getDroppedCount() const;
+
+    /**
+      *   @return Returns the amount of frames written
+      */
+    long getEncodedCount() const;
+
+    /**
+      *   @brief Convert RGBA pixels to I420
+      *   @param rgba RGBA pixels
+      *   @param width Width in pixels
+      *   @param height Height in pixels
+      *   @param yuv Filled with the Y, U and V planes, chroma planes are
+      *   subsampled by two in both directions (rounded up)
+      */
+    static void convertToI420(const sf::Uint8* rgba, unsigned width, unsigned height, std::vector<sf::Uint8>& yuv);
+
+  private:
+
+    /**
+      *   @struct Slot
+      *   @brief Staging buffer of the ring
+      */
+    struct Slot
+    {
+      std::vector<sf::Uint8> pixels; /**< RGBA */
+      std::vector<sf::Uint8> encoded; /**< I420 of the YUV stream */
+      long frame = 0; /**< Frame number */
+    };
+
+    /**
+      *   @brief Worker thread function
+      */
+    void Work();
+
+    /**
+      *   @brief Encode and write one slot
+      *   @param slot Slot to be written
+      */
+    void Encode(Slot& slot);
+
+    std::string directory;
+    Format format;
+    unsigned width;
+    unsigned height;
+    bool open = false;
+
+    std::vector<Slot> ring;
+    std::vector<std::size_t> free_slots; /**< Slots not queued or being encoded */
+    std::deque<std::size_t> queued; /**< Slots waiting for a worker, oldest first */
+    long next_frame = 0; /**< Number of the next submitted frame */
+    long dropped = 0;
+    long encoded_frames = 0;
+    bool finishing = false;
+    mutable std::mutex mutex; /**< Guards the ring state and the counters */
+    std::condition_variable work;
+    std::vector<std::thread> workers;
+
+    std::ofstream stream; /**< capture.yuv */
+    long next_write = 0; /**< Frame whose turn it is to be written to stream */
+    std::mutex write_mutex; /**< Guards stream and next_write */
+    std::condition_variable write_turn;
+};
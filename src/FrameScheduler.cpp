@@ -0,0 +1,134 @@
+/**
+  *   @file FrameScheduler.cpp
+  *   @brief Source code for class FrameScheduler
+  */
+
+#include "FrameScheduler.hpp"
+#include <thread>
+
+/*  Member Initializations */
+const int FrameScheduler::MAX_CATCH_UP_STEPS = 5;
+const std::array<float, FrameScheduler::HISTOGRAM_BUCKETS - 1> FrameScheduler::BUCKET_LIMITS_MS = { 8.f, 17.f, 25.f, 34.f, 50.f };
+
+FrameScheduler::FrameScheduler(Clock::duration step) : step(step)
+{
+  reset(Clock::now());
+}
+
+void FrameScheduler::reset(Clock::time_point now)
+{
+  backlog = Clock::duration::zero();
+  start = now;
+  last_time = now;
+  frame_start = now;
+  first_frame = now;
+  work = Clock::duration::zero();
+  frames = 0;
+  steps = 0;
+  dropped = 0;
+  histogram.fill(0);
+}
+
+int FrameScheduler::beginFrame(Clock::time_point now)
+{
+  backlog += now - last_time;
+  last_time = now;
+  long due = static_cast<long>(backlog / step);
+  if (due == 0)
+  {
+    return 0;
+  }
+  if (due > MAX_CATCH_UP_STEPS)
+  {
+    // Run late, don't try to catch up the whole backlog
+    dropped += due - MAX_CATCH_UP_STEPS;
+    due = MAX_CATCH_UP_STEPS;
+    backlog %= step;
+  }
+  else
+  {
+    backlog -= due * step;
+  }
+  steps += due;
+
+  if (frames > 0)
+  {
+    float frame_ms = std::chrono::duration<float, std::milli>(now - frame_start).count();
+    std::size_t bucket = 0;
+    while (bucket < BUCKET_LIMITS_MS.size() && frame_ms >= BUCKET_LIMITS_MS[bucket])
+    {
+      bucket++;
+    }
+    histogram[bucket]++;
+  }
+  else
+  {
+    first_frame = now;
+  }
+  frames++;
+  frame_start = now;
+  return static_cast<int>(due);
+}
+
+void FrameScheduler::endFrame(Clock::time_point now)
+{
+  work += now - frame_start;
+}
+
+FrameScheduler::Clock::time_point FrameScheduler::nextStep() const
+{
+  return last_time + (step - backlog);
+}
+
+void FrameScheduler::sleepUntil(Clock::time_point due)
+{
+  const auto margin = std::chrono::milliseconds(1);
+  Clock::time_point now = Clock::now();
+  if (due - now > margin)
+  {
+    std::this_thread::sleep_for(due - now - margin);
+  }
+  while (Clock::now() < due)
+  {
+    std::this_thread::yield();
+  }
+}
+
+long FrameScheduler::getFrames() const
+{
+  return frames;
+}
+
+long FrameScheduler::getSteps() const
+{
+  return steps;
+}
+
+long FrameScheduler::getDroppedSteps() const
+{
+  return dropped;
+}
+
+float FrameScheduler::getCpuUtilisation() const
+{
+  Clock::duration wall = last_time - start;
+  if (wall <= Clock::duration::zero())
+  {
+    return 0.f;
+  }
+  return std::chrono::duration<float>(work) / std::chrono::duration<float>(wall);
+}
+
+float FrameScheduler::getAverageFrameMs() const
+{
+  if (frames < 2)
+  {
+    return 0.f;
+  }
+  return std::chrono::duration<float, std::milli>(frame_start - first_frame).count() / (frames - 1);
+}
+
+const std::array<long, FrameScheduler::HISTOGRAM_BUCKETS>& FrameScheduler::getHistogram() const
+{
+  return histogram;
+}
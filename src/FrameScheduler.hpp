@@ -0,0 +1,116 @@
+/**
+  *   @file FrameScheduler.hpp
+  *   @brief Header for FrameScheduler class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+/**
+  *   @class FrameScheduler
+  *   @brief Fixed step simulation with one render per displayed frame
+  *   @details Wall clock time is accumulated and consumed in fixed simulation
+  *   steps. A frame runs the steps that are due and is rendered once. When the
+  *   game falls behind, at most MAX_CATCH_UP_STEPS steps are run and the rest
+  *   of the backlog is dropped, so one slow frame doesn't make the next ones
+  *   slower. Between frames the thread sleeps instead of spinning.
+  *   Frame times and the share of wall time spent working are recorded.
+  */
+class FrameScheduler
+{
+  public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static const int MAX_CATCH_UP_STEPS; /**< Simulation steps run per frame at most */
+    static const std::size_t HISTOGRAM_BUCKETS = 6; /**< Frame time histogram size */
+    static const std::array<float, HISTOGRAM_BUCKETS - 1> BUCKET_LIMITS_MS; /**< Upper limits of the buckets, the last bucket has no limit */
+
+    /**
+      *   @brief Constructor
+      *   @param step Length of one simulation step
+      */
+    explicit FrameScheduler(Clock::duration step);
+
+    /**
+      *   @brief Drop the backlog and the statistics
+      *   @param now Current time
+      */
+    void reset(Clock::time_point now);
+
+    /**
+      *   @brief Start a frame
+      *   @param now Current time
+      *   @return Returns the amount of simulation steps to run. 0 means the
+      *   frame isn't due yet and nothing should be rendered.
+      */
+    int beginFrame(Clock::time_point now);
+
+    /**
+      *   @brief End the frame started by beginFrame
+      *   @param now Time after rendering
+      */
+    void endFrame(Clock::time_point now);
+
+    /**
+      *   @return Returns the time when the next simulation step is due
+      */
+    Clock::time_point nextStep() const;
+
+    /**
+      *   @brief Sleep until the given time
+      *   @details Sleeps most of the wait and yields the last millisecond, sleep
+      *   granularity of the OS is often coarser than a frame
+      *   @param due Time to wake up
+      */
+    static void sleepUntil(Clock::time_point due);
+
+    /**
+      *   @return Returns the amount of rendered frames
+      */
+    long getFrames() const;
+
+    /**
+      *   @return Returns the amount of simulation steps run
+      */
+    long getSteps() const;
+
+    /**
+      *   @return Returns the amount of simulation steps dropped by the catch-up cap
+      */
+    long getDroppedSteps() const;
+
+    /**
+      *   @return Returns share of wall time between beginFrame and endFrame, 0...1
+      */
+    float getCpuUtilisation() const;
+
+    /**
+      *   @return Returns the average time between frames in milliseconds
+      */
+    float getAverageFrameMs() const;
+
+    /**
+      *   @return Returns counts of frame times per bucket, see BUCKET_LIMITS_MS
+      */
+    const std::array<long, HISTOGRAM_BUCKETS>& getHistogram() const;
+
+  private:
+
+    Clock::duration step;
+    Clock::duration backlog{}; /**< Wall time not simulated yet */
+    Clock::time_point start; /**< Time of reset */
+    Clock::time_point last_time; /**< Time of the last beginFrame */
+    Clock::time_point frame_start; /**< Start of the last rendered frame */
+    Clock::time_point first_frame; /**< Start of the first rendered frame */
+    Clock::duration work{}; /**< Time between beginFrame and endFrame of rendered frames */
+    long frames = 0;
+    long steps = 0;
+    long dropped = 0;
+    std::array<long, HISTOGRAM_BUCKETS> histogram{};
+};
@@ -11,6 +11,7 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include <SFML/Window.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
@@ -29,7 +30,8 @@ const float GameEngine::PLAYER_SPEED = 100.f;
 const float GameEngine::PLAYER_ROTATION_DEGREE = 5.f;
 
 GameEngine::GameEngine(sf::RenderWindow &rw)
-    : renderWindow(rw), world(rw, resources) {
+    : renderWindow(rw), renderer(rw, resources, gameFont, std::chrono::microseconds(TIME_PER_FRAME.asMicroseconds())),
+      world(rw, resources) {
 
         playerSprite.setTexture(resources.get(Textures::ID::BlueAirplane_alpha));
         playerSprite.setPosition(100.f,100.f);
@@ -39,81 +41,241 @@ GameEngine::GameEngine(sf::RenderWindow &rw)
         gameInfo.setPosition(10.f,10.f);
         gameInfo.setCharacterSize(10);
 
+        camera.reset(sf::FloatRect(0.f, 0.f, Game::WIDTH, Game::HEIGHT));
+
         isGameEngineReady = true;
         GameOver = false;
 }
 
 
 /**
- * Handle inputs and draw textures to the screen.
- * This function passes constant TIME_PER_FRAME to update function to achieve fixed time steps.
+ * Handle inputs and publish the world to the render thread.
+ * The world is simulated in fixed TIME_PER_FRAME steps, frames scheduler decides
+ * how many steps are due. Events are handled and a frame is published once per frame.
  * Otherwise the game can be laggy and players can pass through a wall + easier to debug.
  */
 void GameEngine::run(std::string &level_file)
+{
+  gameLoop(level_file);
+  // Menus draw on this thread
+  renderer.stop();
+}
+
+void GameEngine::gameLoop(std::string &level_file)
 {
   world.clear_all();
 
-  world.read_level(level_file, gameMode);
+  // Level file is read once per run, restarts use the snapshot
+  currentLevel = level_file;
+  if (! world.read_level(level_file, gameMode)) {
+    // read_level printed what is wrong with the file, back to the menu
+    return;
+  }
+  world.take_snapshot(level_snapshot, level_file, gameMode);
+  camera.setCenter(Game::WIDTH / 2.f, Game::HEIGHT / 2.f);
 
-  sf::Time lastUpdateTime = sf::Time::Zero;
-  sf::Clock clock;
+  renderer.setVerticalSync(vsync);
+  renderer.setRecorder(recorder, ! headless);
+  frames.reset(FrameScheduler::Clock::now());
   score_clock = sf::Clock();
   while(renderWindow.isOpen())
   {
-    /*restart function returns elapsed time and reset the clock to zero to get elapsed time of next iteration.*/
-    sf::Time elapsedTime = clock.restart();
-    lastUpdateTime += elapsedTime;
+    // Render thread is paced by the display, this loop only by the steps
+    int steps = frames.beginFrame(FrameScheduler::Clock::now());
+    if (steps == 0)
+    {
+      // Give the CPU away until the next step is due
+      FrameScheduler::sleepUntil(frames.nextStep());
+      continue;
+    }
 
-    /* Time to handle events, update world and display. */
-    while(lastUpdateTime > TIME_PER_FRAME)
+    // Handle events
+    sf::Event event{};
+    while(renderWindow.pollEvent(event))
     {
-      lastUpdateTime -= TIME_PER_FRAME;
-      // Handle events
-      sf::Event event{};
-      while(renderWindow.pollEvent(event))
-      {
-        if (GameOver) {
-          // Use special event handler when game is over
-          if (gameOverHandler(event, level_file))
-          {
-            // Return to MainMenu
-            return;
-          }
+      if (GameOver) {
+        // Use special event handler when game is over
+        if (gameOverHandler(event, level_file))
+        {
+          // Return to MainMenu
+          return;
         }
+      }
 
-        if(event.type == sf::Event::KeyPressed)
+      if(event.type == sf::Event::KeyPressed)
+      {
+        if(event.key.code == sf::Keyboard::Escape)
         {
-          if(event.key.code == sf::Keyboard::Escape)
-          {
+          reportLevelStats(level_file);
+          return;
+        }
+        if(event.key.code == sf::Keyboard::F5)
+        {
+          if (! restartLevel(level_file)) {
             return;
           }
         }
+        if(event.key.code == sf::Keyboard::F3)
+        {
+          showStats = !showStats;
+        }
+        if(event.key.code == sf::Keyboard::F4)
+        {
+          vsync = !vsync;
+          renderer.setVerticalSync(vsync);
+        }
+        if(event.key.code == sf::Keyboard::F6)
+        {
+          showMinimap = !showMinimap;
+        }
       }
+    }
+
+    for (int step = 0; step < steps && !GameOver; step++)
+    {
       update(TIME_PER_FRAME);
+      GameResult result = world.update(gameMode);
+      if (result != GameResult::UnFinished) {
+        // Game over
+        createGameOver(result);
+        if (headless) {
+          // Nobody to answer the game over screen
+          return;
+        }
+      }
+    }
+    if (max_steps > 0 && frames.getSteps() >= max_steps) {
+      // Recorded long enough
+      reportLevelStats(level_file);
+      return;
+    }
+    if (GameOver) {
+      // Game over screen is drawn here, the window context comes back
+      renderer.stop();
       render();
     }
+    else {
+      renderer.start();
+      publishFrame();
+    }
+    frames.endFrame(FrameScheduler::Clock::now());
+  }
+}
+
+void GameEngine::setRenderScale(float scale, bool automatic)
+{
+  renderer.setResolutionScale(scale, automatic);
+}
 
+void GameEngine::publishFrame()
+{
+  RenderFrame &frame = renderer.back();
+  frame.clear();
+  updateCamera(frame);
+  // Render thread moves the camera between the two positions
+  float left = std::min(frame.previous_camera.x, frame.camera.x) - Game::WIDTH / 2.f;
+  float width = std::abs(frame.camera.x - frame.previous_camera.x) + Game::WIDTH;
+  world.publish(frame, sf::FloatRect(left, 0.f, width, Game::HEIGHT));
+  if (showMinimap) {
+    frame.minimap = world.getMinimap();
   }
+  frame.info = gameInfoText();
+  renderer.publish();
 }
 
 void GameEngine::render()
 {
   renderWindow.clear(sf::Color(150,200,255));
-  if (GameOver) {
-    // Draw only gameover screen
-    drawGameOver();
+  // Draw only gameover screen
+  drawGameOver();
+  gameInfo.setString(gameInfoText());
+  renderWindow.draw(gameInfo);
+  renderWindow.display();
+}
+bool GameEngine::restartLevel(std::string &level_file)
+{
+  if (! world.restore_snapshot(level_snapshot)) {
+    // No snapshot (e.g. level was empty), fall back to reading the file
+    world.clear_all();
+    if (! world.read_level(level_file, gameMode)) {
+      return false;
+    }
   }
-  else {
-    // Draw only normal game view
-    GameResult result = world.update(gameMode);
-    if (result != GameResult::UnFinished) {
-      // Game over
-      createGameOver(result);
+  camera.setCenter(Game::WIDTH / 2.f, Game::HEIGHT / 2.f);
+  score_clock.restart();
+  score = 0;
+  GameOver = false;
+  return true;
+}
+
+void GameEngine::reportLevelStats(const std::string &level_file)
+{
+  const WorldStats &stats = world.getStats();
+  if (stats.ticks == 0) {
+    return;
+  }
+  std::cout << level_file << ": " << stats.ticks << " ticks, contacts avg "
+            << stats.total_contacts / stats.ticks << " peak " << stats.peak_contacts
+            << ", active entities avg " << stats.total_active_entities / stats.ticks << " of " << stats.entities
+            << ", active bodies avg " << stats.total_active_bodies / stats.ticks << " of " << stats.bodies
+            << ", terrain " << stats.terrain_boxes << " boxes -> " << stats.terrain_proxies << " proxies"
+            << ", bullets left " << stats.live_bullets << " (" << stats.bullets_expired << " expired, "
+            << stats.bullets_out_of_bounds << " out of bounds), " << stats.detonations << " bomb detonations"
+            << ", reinforcements " << stats.reinforcements << " (spawn avg "
+            << (stats.reinforcements > 0 ? stats.spawn_micros_total / stats.reinforcements : 0.0)
+            << " us peak " << stats.spawn_micros_peak << " us, " << stats.pooled_units << " pooled)" << std::endl;
+  std::cout << "frames " << frames.getFrames() << " (avg " << frames.getAverageFrameMs() << " ms, cpu "
+            << 100.f * frames.getCpuUtilisation() << " %, " << frames.getSteps() << " steps, "
+            << frames.getDroppedSteps() << " dropped), frame times:";
+  const auto &histogram = frames.getHistogram();
+  for (std::size_t i = 0; i < histogram.size(); i++) {
+    if (i < FrameScheduler::BUCKET_LIMITS_MS.size()) {
+      std::cout << " <" << FrameScheduler::BUCKET_LIMITS_MS[i] << " ms: " << histogram[i];
+    }
+    else {
+      std::cout << " longer: " << histogram[i];
     }
   }
-  updateGameInfo();
-  renderWindow.display();
+  std::cout << std::endl;
+  std::cout << "render thread: " << renderer.getFrames() << " frames, draw avg "
+            << renderer.getAverageDrawMs() << " ms, scenery layer drawn " << renderer.getSceneryRenders()
+            << " times + " << renderer.getSceneryRegionRenders() << " regions, "
+            << stats.minimap_images << " minimap images" << std::endl;
+  if (recorder != nullptr) {
+    std::cout << "recording: " << recorder->getCapturedCount() << " frames captured, "
+              << recorder->getDroppedCount() << " dropped, " << recorder->getEncodedCount() << " encoded" << std::endl;
+  }
+}
+
+void GameEngine::updateCamera(RenderFrame &frame)
+{
+  std::deque<std::shared_ptr<Entity>> &planes = world.get_player_planes();
+  if (planes.empty()) {
+    // Keep the last position
+    frame.previous_camera = frame.camera = camera.getCenter();
+    return;
+  }
+  // Follow player planes (middle point of both planes in multiplayer),
+  // render thread moves the camera from the previous step to this one
+  float previous_x = 0;
+  float x = 0;
+  for (const auto &plane : planes) {
+    previous_x += plane->getRenderPosition(0.f).x;
+    x += plane->getRenderPosition(1.f).x;
+  }
+  previous_x /= planes.size();
+  x /= planes.size();
+
+  // Don't scroll outside the level
+  float half_width = Game::WIDTH / 2.f;
+  float max_x = std::max(half_width, world.getLevelWidth() - half_width);
+  previous_x = std::max(half_width, std::min(previous_x, max_x));
+  x = std::max(half_width, std::min(x, max_x));
+  frame.previous_camera = sf::Vector2f(previous_x, Game::HEIGHT / 2.f);
+  frame.camera = sf::Vector2f(x, Game::HEIGHT / 2.f);
+  camera.setCenter(frame.camera);
 }
+
 void GameEngine::playerMoveUp(int player_number)
 {
   std::deque<std::shared_ptr<Entity>> planes = world.get_player_planes();
@@ -210,16 +372,22 @@ void GameEngine::playerShoot(int player_number)
   if (player_entity.getFacing()) {
     // facing right, shoot right
     sf::Vector2f vec(cos(player_body->GetAngle()), sin(player_body->GetAngle()));
-    player_entity.shoot(vec, resources);
+    player_entity.shoot(vec);
   }
   else {
     // facing left, shoot left
     sf::Vector2f vec(- cos(player_body->GetAngle()), - sin(player_body->GetAngle()));
-    player_entity.shoot(vec, resources);
+    player_entity.shoot(vec);
   }
 
 }
 
+void GameEngine::playerDropBomb(int player_number)
+{
+  std::deque<std::shared_ptr<Entity>> planes = world.get_player_planes();
+  planes[player_number]->dropBomb();
+}
+
 
 /* Sum all inputs (movements and rotations) and set new position and orientation in two function call: move and rotate. */
 void GameEngine::update(sf::Time  /*elapsedTime*/)
@@ -258,6 +426,9 @@ void GameEngine::update(sf::Time  /*elapsedTime*/)
       // shoot world player_planes[0]
       playerShoot(0);
     }
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::X)) {
+      playerDropBomb(0);
+    }
 
     if ((planes.size()==2) && (gameMode == Game::GameMode::Multiplayer)) {
       player2_set = true;
@@ -287,6 +458,9 @@ void GameEngine::update(sf::Time  /*elapsedTime*/)
       if (sf::Keyboard::isKeyPressed(sf::Keyboard::M)) {
         playerShoot(1);
       }
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::N)) {
+        playerDropBomb(1);
+      }
     }
 
     //set forces to 0
@@ -308,7 +482,7 @@ void GameEngine::update(sf::Time  /*elapsedTime*/)
 
 }
 
-void GameEngine::updateGameInfo()
+std::string GameEngine::gameInfoText()
 {
   /*Game info to display*/
 
@@ -326,8 +500,28 @@ void GameEngine::updateGameInfo()
     display_information << "Player 2 | hitpoints: " << player_plane->getHitPoints()
                         << " | killed: " << player_plane->getGrandTotalKill() << "\n";
   }
-  gameInfo.setString(display_information.str());
-  renderWindow.draw(gameInfo);
+  if (showStats)
+  {
+    const WorldStats &stats = world.getStats();
+    display_information << "entities: " << stats.active_entities << " of " << stats.entities << " active | bodies: "
+                        << stats.active_bodies << " of " << stats.bodies << " active\n"
+                        << "proxies: " << stats.proxies
+                        << " | contacts: " << stats.contacts << " (touching " << stats.touching_contacts << ")\n"
+                        << "terrain: " << stats.terrain_boxes << " boxes -> " << stats.terrain_proxies << " proxies\n"
+                        << "bullets: " << stats.live_bullets << " live | " << stats.bullets_expired << " expired | "
+                        << stats.bullets_out_of_bounds << " out of bounds | " << stats.detonations << " bombs\n"
+                        << "particles: " << stats.live_particles << " live | " << stats.particles_dropped << " dropped\n"
+                        << "reinforcements: " << stats.reinforcements << " | " << stats.pooled_units << " pooled | spawn peak "
+                        << stats.spawn_micros_peak << " us\n"
+                        << "frame: " << frames.getAverageFrameMs() << " ms | cpu " << 100.f * frames.getCpuUtilisation()
+                        << " % | dropped steps " << frames.getDroppedSteps() << (vsync ? " | vsync" : "") << "\n"
+                        << "render thread: " << renderer.getFrames() << " frames | draw " << renderer.getAverageDrawMs() << " ms | scenery "
+                        << renderer.getSceneryRenders() << " full, " << renderer.getSceneryRegionRenders() << " regions | scale "
+                        << static_cast<int>(100.f * renderer.getResolutionScale() + 0.5f) << " %\n"
+                        << "culling: world " << stats.visible_entities << " visible, " << stats.culled_entities
+                        << " culled | drawn " << renderer.getDrawnCount() << ", culled " << renderer.getCulledCount() << "\n";
+  }
+  return display_information.str();
 }
 
 bool GameEngine::gameOverHandler(sf::Event &event, std::string &level_path)
@@ -360,19 +554,20 @@ bool GameEngine::gameOverHandler(sf::Event &event, std::string &level_path)
 void GameEngine::createGameOver(GameResult result)
 {
   //  Clear level
+  reportLevelStats(currentLevel);
   world.clear_all();
 
   if (gameMode == Game::GameMode::SinglePlayer) {
     // Single player, create valid name_input
     // Set also info text
-    name_input_info = sf::Text("Enter name and press Enter", gameFont, 20);
+    name_input_info = sf::Text("Enter name and press Enter (F5 to restart)", gameFont, 20);
     name_input = TextInput(Game::WIDTH / 2 - 75, Game::HEIGHT / 2, 150, 30);
     name_input.activate();
   }
   else {
     // Create empty name_input
     name_input = TextInput();
-    name_input_info = sf::Text("Press Enter to return Main Menu", gameFont, 20);
+    name_input_info = sf::Text("Press Enter to return Main Menu (F5 to restart)", gameFont, 20);
   }
   name_input_info.setPosition(Game::WIDTH / 2 - 110, Game::HEIGHT / 2 - 50);
   name_input_info.setFillColor(sf::Color::Black);
@@ -455,6 +650,13 @@ void GameEngine::logStats(std::string level_path, const std::string& user_name,
 
 }
 
+void GameEngine::setRecording(FrameRecorder* frame_recorder, bool headless, long steps)
+{
+  recorder = frame_recorder;
+  this->headless = headless;
+  max_steps = steps;
+}
+
 void GameEngine::setGameMode(Game::GameMode gameMode)
 {
   this->gameMode = gameMode;
@@ -7,6 +7,8 @@
 #include "World.hpp"
 #include "ResourceManager.hpp"
 #include "TextInput.hpp"
+#include "FrameScheduler.hpp"
+#include "RenderThread.hpp"
 
 /**
   *   @class GameEngine
@@ -35,6 +37,24 @@ class GameEngine : private sf::NonCopyable
   static const float PLAYER_SPEED; /**< Player movement speed per input. */
   static const float PLAYER_ROTATION_DEGREE; /**< Player rotation degree.*/
 
+  /**
+    *   @brief Record the game frames
+    *   @details Every simulation step is captured by the render thread
+    *   @param frame_recorder Recorder, nullptr stops recording
+    *   @param headless Nothing is shown and run returns at game over
+    *   @param steps run returns after this many simulation steps, 0 doesn't limit
+    */
+  void setRecording(FrameRecorder* frame_recorder, bool headless, long steps);
+
+  /**
+    *   @brief Set the resolution the level is drawn at
+    *   @param scale Share of the window resolution, 0.5...1
+    *   @param automatic Lower the scale when drawing takes longer than a
+    *   frame, scale is the highest scale used
+    *   @see RenderThread::setResolutionScale
+    */
+  void setRenderScale(float scale, bool automatic);
+
   /**
     *   @brief Set gameMode
     *   @param gameMode true -> single_player, false -> multiplayer
@@ -46,21 +66,52 @@ class GameEngine : private sf::NonCopyable
    *@brief Process all events and inputs from the user.
    */
   void processEvents();
+  /**
+   * @brief Simulation loop of run
+   * @param level_file Level path
+   */
+  void gameLoop(std::string &level_file);
   /**
    * @brief Update the Box2d world.
    * @param elapsedTime Box2d world after .
-   * @see updateGameInfo()
+   * @see gameInfoText()
    */
   void update(sf::Time elapsedTime);
   /**
-   *@brief Update game or Box2d world information.
+   *@brief Game or Box2d world information.
+   *@return Returns the text shown in the corner
    */
-  void updateGameInfo();
+  std::string gameInfoText();
   /**
-   * @brief Clear current view and display updates.
-   * @see update(), updateGameInfo()
+   * @brief Copy the world, camera and game info to the render thread
+   * @see RenderThread
+   */
+  void publishFrame();
+  /**
+   * @brief Draw the game over screen on this thread
+   * @remark Render thread must be stopped
+   * @see gameInfoText()
    */
   void render();
+  /**
+   * @brief Restart the level from level_snapshot
+   * @details Doesn't read or parse the level file
+   * @param level_file Level path, read only if there is no snapshot
+   * @return Returns false if the level file couldn't be read, the game
+   * should return to the main menu
+   */
+  bool restartLevel(std::string &level_file);
+  /**
+   * @brief Print contact counts and frame times of the level to stdout
+   * @param level_file Level path
+   */
+  void reportLevelStats(const std::string &level_file);
+  /**
+   * @brief Center camera to the player planes
+   * @details Camera scrolls horizontally but stays inside the level
+   * @param frame Frame whose camera positions of the last two steps are set
+   */
+  void updateCamera(RenderFrame &frame);
   /**
    * @brief Handle player input.
    * @see processEvents()
@@ -105,6 +156,7 @@ class GameEngine : private sf::NonCopyable
   void playerRotateCounterClockWise(int player_number);
   void playerRotateClockWise(int player_number);
   void playerShoot(int player_number);
+  void playerDropBomb(int player_number);
 
 
   sf::RenderWindow &renderWindow; /**< Display window for game engine */
@@ -113,9 +165,20 @@ class GameEngine : private sf::NonCopyable
   sf::Sprite playerSprite; /**< Player object with texture.*/
   sf::Font gameFont; /**< Game font type and size*/
   sf::Text gameInfo; /**< To write game info on screen.*/
+  sf::View camera; /**< World view, follows player planes on levels wider than the window */
 
   bool isGameEngineReady; /**< Is the game ended*/
+  bool showStats = false; /**< Show World physics counters in game info, toggled with F3 */
+  bool vsync = false; /**< Wait for vertical sync in display, toggled with F4 */
+  bool showMinimap = true; /**< Draw units of the whole level in the corner, toggled with F6 */
+  FrameScheduler frames{std::chrono::microseconds(TIME_PER_FRAME.asMicroseconds())}; /**< Simulation steps and frame statistics of the run */
+  RenderThread renderer; /**< Draws the published frames while the game is running */
+  FrameRecorder* recorder = nullptr; /**< Records the frames if set */
+  bool headless = false; /**< Recording without a visible window */
+  long max_steps = 0; /**< Steps recorded at most, 0 doesn't limit */
   World world;
+  WorldSnapshot level_snapshot; /**< World right after the level was read, used to restart */
+  std::string currentLevel; /**< Level path given to run */
 
   bool GameOver; /**< Game over -> show TextInput */
   Game::GameMode gameMode;
@@ -23,6 +23,7 @@ class Ground : public Entity {
    *   @param b Grounds body for collisions
    *   @param t Grounds texture
    *   @param position Place as vector where Ground is created
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Ground(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position);
+  Ground(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 };
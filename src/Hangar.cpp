@@ -1,5 +1,8 @@
 #include "Hangar.hpp"
 
-Hangar::Hangar(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position, Game::TEAM_ID team):Entity(w, b, t, position, 0.f, 0, 0, 0, 40, sf::Vector2f(1.0f, 0.0f), team){ 
-  typeId = Game::TYPE_ID::hangar;
-  }
+/*  Member Initializations */
+const int Hangar::POOLED_PLANES = 2;
+const int Hangar::POOLED_INFANTRY = 4;
+const float Hangar::REINFORCEMENT_INTERVAL = 5.f;
+
+Hangar::Hangar(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype) : Entity(w, b, t, position, prototype) {}
@@ -12,18 +12,25 @@
 /**
   *   @class Hangar
   *   @brief Entity based Hangar objects 
+  *   @details Hangars send replacement planes and infantry when their team
+  *   has fewer of them than at the start of the level. World pre-creates
+  *   the units at level load.
   */
 
 class Hangar : public Entity {
   public:
 
+  static const int POOLED_PLANES; /**< Reinforcement planes pre-created per hangar */
+  static const int POOLED_INFANTRY; /**< Reinforcement infantry pre-created per hangar */
+  static const float REINFORCEMENT_INTERVAL; /**< Seconds between reinforcements of one hangar */
+
   /**
    *   @brief Construct a Hangar object.
    *   @param w Gameworld where Hangar is created in
    *   @param b Hangars body for collisions
    *   @param t Hangars texture
    *   @param position Place as vector where Hangar is created
-   *   @param team Hangars team
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Hangar(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position, Game::TEAM_ID team);
+  Hangar(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 };
@@ -8,7 +8,6 @@
 
 #include <SFML/Graphics.hpp>
 #include "Entity.hpp"
-#include "Bullet.hpp"
 /**
   *   @class Infantry
   *   @brief Entity based Infantry objects
@@ -25,9 +24,9 @@ class Infantry : public Entity {
    *   @param b infantrys body for collisions
    *   @param t infantrys texture
    *   @param position Place as vector where infantry is created
-   *   @param team infantrys team
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Infantry(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, Game::TEAM_ID team);
+  Infantry(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 
   virtual void moveLeft() override;
 
@@ -37,5 +36,5 @@ class Infantry : public Entity {
      *   @brief give permission for object to shoot
      *   @return Return true or false based on if the object can shoot or not
      */
-  virtual bool shoot(sf::Vector2f direction, ResourceManager& resources)  override;
+  virtual bool shoot(sf::Vector2f direction)  override;
 };
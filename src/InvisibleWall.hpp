@@ -24,6 +24,7 @@ class InvisibleWall : public Entity {
    *   @param b InvisibleWall body for collisions
    *   @param t InvisibleWall texture
    *   @param position Place as vector where InvisibleWall is created
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  InvisibleWall(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position);
+  InvisibleWall(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 };
@@ -333,13 +333,40 @@ void Level::removeCurrent()
 /*  Draw Level */
 void Level::drawLevel(sf::RenderWindow &window)
 {
-  // Draw all LevelEntities
+  // Draw LevelEntities the view shows
+  const sf::View &view = window.getView();
+  const sf::FloatRect visible(view.getCenter() - view.getSize() / 2.f, view.getSize());
+  draw_frames++;
   for (auto & level_entitie : level_entities)
   {
-    window.draw( (*level_entitie) );
+    sf::FloatRect bounds(level_entitie->getX(), level_entitie->getY(), level_entitie->getWidth(), level_entitie->getHeight());
+    if (visible.intersects(bounds))
+    {
+      window.draw( (*level_entitie) );
+      drawn_count++;
+    }
+    else
+    {
+      culled_count++;
+    }
   }
 }
 
+long Level::getDrawFrames() const
+{
+  return draw_frames;
+}
+
+long Level::getDrawnCount() const
+{
+  return drawn_count;
+}
+
+long Level::getCulledCount() const
+{
+  return culled_count;
+}
+
 /*  Draw Level to texture */
 void Level::drawTexture(sf::RenderTexture &texture)
 {
@@ -434,9 +461,9 @@ std::ostream& operator<<(std::ostream &os, const Level &level)
   os << "InvisibleWall;0;" <<  Game::HEIGHT << ";1;" << max_width + 1 << ";1" << std::endl;
   // Left Wall
   os << "InvisibleWall;0;0;1;1;" << Game::HEIGHT << std::endl;
-  // Right Wall
-  //os << "InvisibleWall;" << max_width + 1 << ";0;1;1;" << Game::HEIGHT << std::endl;
-  os << "InvisibleWall;" << Game::WIDTH << ";0;1;1;" << Game::HEIGHT << std::endl;
+  // Right Wall (levels can be wider than the window, the game scrolls)
+  float right_x = std::max(max_width + 1, static_cast<float>(Game::WIDTH));
+  os << "InvisibleWall;" << right_x << ";0;1;1;" << Game::HEIGHT << std::endl;
 
   return os;
 }
@@ -735,117 +762,64 @@ float Level::getLevelWidth() const
 /*  Parse Level from file */
 bool Level::parseLevel(std::string& levelfile)
 {
-  float x, y, width, height;
-  int orientation, entity_name;
-
-  std::ifstream file(levelfile);
-  if (file.is_open())
+  LevelParser parser;
+  if (! parser.open(levelfile))
   {
-    // Remove old entities
-    clearAll();
-    bool comments_read = false;
-    std::string line;
-    while(getline(file, line))
+    parser.printDiagnostics(std::cout, levelfile);
+    return false;
+  }
+  // Remove old entities
+  clearAll();
+  LevelRecord record;
+  while (parser.next(record))
+  {
+    int entity_name = ConvertStrToType(record.type);
+    auto x = static_cast<float>(record.x);
+    auto y = static_cast<float>(record.y);
+    auto width = static_cast<float>(record.width);
+    auto height = static_cast<float>(record.height);
+
+    // Line parsed, add new entity to Level
+    if (entity_name == GROUND_ENTITY)
     {
-      if (! comments_read)
-      {
-        if (line.find("*/") != std::string::npos)
-        {
-          // End comment mark found
-          comments_read = true;
-        }
-      }
-      else
+      // Ground entity is special entity (needs to be stretched to correct size)
+      std::shared_ptr<LevelEntity> ground = std::make_shared<LevelEntity>
+            (x, y, Level::ground_width, Level::ground_height, manager.get(Textures::Ground_alpha), GROUND_ENTITY);
+      ground->setPositioned(true);
+      ground->setFullyConstructed();
+      ground->setNonFlippable();
+      // Stretch to the correct size
+      ground->setStretchable(true);
+      ground->autoStretch(width, height);
+
+
+
+      // Update ground level
+      UpdateGroundLevel(x, x + width, y);
+      // Push to the containers
+      grounds.push_back(ground);
+      level_entities.push_back(ground);
+
+    }
+    else
+    {
+      // For other entities use just addEntity (must be called two times)
+      // This calls AddEntity which locks entities the second time
+      addEntity(x, y, entity_name);
+      // Now set the correct orientation
+      if (record.orientation == 0)
       {
-        // Try to parse line to 6 sections with ; as separator
-        std::istringstream temp_stream(line);
-        // Use getline to parse inputstringstream
-        std::string split_str;
-        int i = 0;
-        while(getline(temp_stream, split_str, ';'))
-        {
-          try
-          {
-            switch (i)
-            {
-              // Own container would be a better solution (could be filled by container[i] = ..)
-              case 0:
-                entity_name = ConvertStrToType(split_str);
-                break;
-              case 1:
-                x = std::stod(split_str);
-                break;
-              case 2:
-                y = std::stod(split_str);
-                break;
-              case 3:
-                orientation = std::stoi(split_str);
-                break;
-              case 4:
-                width = std::stod(split_str);
-                break;
-              case 5:
-                height = std::stod(split_str);
-                break;
-
-            }
-            i ++;
-
-          } catch (std::exception &e)
-          {
-            std::cout << e.what() << std::endl;
-            // Fail
-            clearAll();
-            return false;
-          }
-        }
-        // One line read
-        if (i != 6 )
-        {
-          // Fail
-          clearAll();
-          return false;
-        }
-        
-        
-          // Everything went ok, add new entity to Level
-          if (entity_name == GROUND_ENTITY)
-          {
-            // Ground entity is special entity (needs to be stretched to correct size)
-            std::shared_ptr<LevelEntity> ground = std::make_shared<LevelEntity>
-                  (x, y, Level::ground_width, Level::ground_height, manager.get(Textures::Ground_alpha), GROUND_ENTITY);
-            ground->setPositioned(true);
-            ground->setFullyConstructed();
-            ground->setNonFlippable();
-            // Stretch to the correct size
-            ground->setStretchable(true);
-            ground->autoStretch(width, height);
-
-
-
-            // Update ground level
-            UpdateGroundLevel(x, x + width, y);
-            // Push to the containers
-            grounds.push_back(ground);
-            level_entities.push_back(ground);
-
-          }
-          else
-          {
-            // For other entities use just addEntity (must be called two times)
-            // This calls AddEntity which locks entities the second time
-            addEntity(x, y, entity_name);
-            // Now set the correct orientation
-            if (orientation == 0)
-            {
-              current_entity->flipLevelEntity(); // current_entity is updated by AddEntity
-            }
-            addEntity(x, y, entity_name);
-          }
-        
+        current_entity->flipLevelEntity(); // current_entity is updated by AddEntity
       }
+      addEntity(x, y, entity_name);
     }
-
+  }
+  if (parser.failed())
+  {
+    // Malformed line, fail
+    parser.printDiagnostics(std::cout, levelfile);
+    clearAll();
+    return false;
   }
   return true;
 
@@ -865,7 +839,7 @@ void Level::clearAll()
 
 
 /*  Convert str to Entity type */
-int Level::ConvertStrToType(std::string &str)
+int Level::ConvertStrToType(std::string_view str)
 {
   if (str == "BlueAirplane") { return FRIENDLY_PLANE;
   } if (str == "RedAirplane") { return HOSTILE_PLANE;
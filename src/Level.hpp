@@ -12,11 +12,14 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <experimental/filesystem>
 #include "LevelEntity.hpp"
 #include "ResourceManager.hpp"
+#include "LevelParser.hpp"
 
 
 /*  Macros */
@@ -105,10 +108,27 @@ class Level
 
     /**
       *   @brief Draw Level
+      *   @details Each LevelEntity is tested against the current view of the
+      *   window, the ones outside it aren't drawn
       *   @param window RenderWindow where the Level is drawn
       */
     void drawLevel(sf::RenderWindow &window);
 
+    /**
+      *   @return Returns the amount of drawLevel calls
+      */
+    long getDrawFrames() const;
+
+    /**
+      *   @return Returns the amount of LevelEntities drawn by all drawLevel calls
+      */
+    long getDrawnCount() const;
+
+    /**
+      *   @return Returns the amount of LevelEntities culled by all drawLevel calls
+      */
+    long getCulledCount() const;
+
     /**
       *   @brief Draw Level to RenderTexture
       *   @param texture RenderTexture where Level is drawn
@@ -285,7 +305,7 @@ class Level
       *   On error case returns NO_ENTITY int value
       *   @param str Input string which is converted
       */
-    int ConvertStrToType(std::string &str);
+    int ConvertStrToType(std::string_view str);
 
     /**
       *   @brief Count specific LevelEntities
@@ -302,5 +322,8 @@ class Level
     std::vector<std::shared_ptr<LevelEntity>> grounds; /**< All ground entities are also added here */
     std::map <unsigned, unsigned> ground_level; /**< Stores the ground level below */
     ResourceManager manager;
+    long draw_frames = 0; /**< Calls of drawLevel */
+    long drawn_count = 0; /**< LevelEntities drawn by all drawLevel calls */
+    long culled_count = 0; /**< LevelEntities outside the view in all drawLevel calls */
 
 };
@@ -535,6 +535,10 @@ void LevelEditor::help_button_action()
 
 void LevelEditor::quit_button_action()
 {
+  long frames = std::max(level.getDrawFrames(), 1L);
+  std::cout << "Editor: " << level.getDrawFrames() << " frames, " << level.getDrawnCount() / frames
+            << " entities drawn and " << level.getCulledCount() / frames
+            << " culled outside the view per frame" << std::endl;
   // First clear all entities from level
   level.clearAll();
 
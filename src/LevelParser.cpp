@@ -0,0 +1,195 @@
+/**
+  *   @file LevelParser.cpp
+  *   @brief Source code for class LevelParser
+  */
+
+#include "LevelParser.hpp"
+#include <charconv>
+#include <fstream>
+
+namespace
+{
+  const char FIELD_SEPARATOR = ';';
+  const unsigned FIELD_COUNT = 6;
+
+  /*  Strip spaces, tabs and carriage returns from both ends */
+  std::string_view trim(std::string_view str)
+  {
+    std::size_t begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos)
+    {
+      return {};
+    }
+    std::size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+  }
+
+  /*  Parse whole field to a number, trailing characters are an error */
+  template <typename T>
+  bool parseNumber(std::string_view str, T &value)
+  {
+    const char *last = str.data() + str.size();
+    auto result = std::from_chars(str.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last;
+  }
+} // namespace
+
+/*  Read whole file to buffer */
+bool LevelParser::open(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  if (! file.is_open())
+  {
+    setContent(std::string());
+    AddDiagnostic(0, "cannot open file");
+    return false;
+  }
+  std::string content;
+  file.seekg(0, std::ios::end);
+  std::streamoff size = file.tellg();
+  if (size > 0)
+  {
+    content.resize(static_cast<std::size_t>(size));
+    file.seekg(0, std::ios::beg);
+    file.read(&content[0], size);
+  }
+  setContent(std::move(content));
+  return true;
+}
+
+/*  Reset parser state to the new content */
+void LevelParser::setContent(std::string content)
+{
+  buffer = std::move(content);
+  position = 0;
+  line_number = 0;
+  comments_read = false;
+  diagnostics.clear();
+}
+
+/*  Parse next entity line */
+bool LevelParser::next(LevelRecord& record)
+{
+  if (failed())
+  {
+    // Don't continue after the first error
+    return false;
+  }
+  while (position < buffer.size())
+  {
+    std::size_t end = buffer.find('\n', position);
+    if (end == std::string::npos)
+    {
+      end = buffer.size();
+    }
+    std::string_view line(buffer.data() + position, end - position);
+    position = end + 1;
+    line_number ++;
+
+    if (! comments_read)
+    {
+      if (line.find("*/") != std::string_view::npos)
+      {
+        // End comment mark found
+        comments_read = true;
+      }
+    }
+    else if (! trim(line).empty())
+    {
+      return ParseLine(line, record);
+    }
+  }
+  return false;
+}
+
+/*  Parse fields of one line */
+bool LevelParser::ParseLine(std::string_view line, LevelRecord& record)
+{
+  // A trailing separator doesn't start a new field
+  line = trim(line);
+  if (line.back() == FIELD_SEPARATOR)
+  {
+    line.remove_suffix(1);
+  }
+  std::string_view fields[FIELD_COUNT];
+  unsigned count = 0;
+  std::size_t begin = 0;
+  while (begin <= line.size())
+  {
+    std::size_t end = line.find(FIELD_SEPARATOR, begin);
+    if (end == std::string_view::npos)
+    {
+      end = line.size();
+    }
+    if (count < FIELD_COUNT)
+    {
+      fields[count] = trim(line.substr(begin, end - begin));
+    }
+    count ++;
+    begin = end + 1;
+  }
+  if (count != FIELD_COUNT)
+  {
+    AddDiagnostic(count < FIELD_COUNT ? count : FIELD_COUNT,
+                  "expected 6 fields, found " + std::to_string(count));
+    return false;
+  }
+
+  record.line = line_number;
+  record.type = fields[0];
+  if (record.type.empty())
+  {
+    AddDiagnostic(0, "missing entity type");
+    return false;
+  }
+  if (! parseNumber(fields[1], record.x))
+  {
+    AddDiagnostic(1, "invalid x coordinate '" + std::string(fields[1]) + "'");
+    return false;
+  }
+  if (! parseNumber(fields[2], record.y))
+  {
+    AddDiagnostic(2, "invalid y coordinate '" + std::string(fields[2]) + "'");
+    return false;
+  }
+  if (! parseNumber(fields[3], record.orientation))
+  {
+    AddDiagnostic(3, "invalid orientation '" + std::string(fields[3]) + "'");
+    return false;
+  }
+  if (! parseNumber(fields[4], record.width))
+  {
+    AddDiagnostic(4, "invalid width '" + std::string(fields[4]) + "'");
+    return false;
+  }
+  if (! parseNumber(fields[5], record.height))
+  {
+    AddDiagnostic(5, "invalid height '" + std::string(fields[5]) + "'");
+    return false;
+  }
+  return true;
+}
+
+bool LevelParser::failed() const
+{
+  return ! diagnostics.empty();
+}
+
+const std::vector<LevelDiagnostic>& LevelParser::getDiagnostics() const
+{
+  return diagnostics;
+}
+
+void LevelParser::printDiagnostics(std::ostream& os, const std::string& filename) const
+{
+  for (const auto& diagnostic : diagnostics)
+  {
+    os << filename << ":" << diagnostic.line << ": field " << diagnostic.field
+       << ": " << diagnostic.message << std::endl;
+  }
+}
+
+void LevelParser::AddDiagnostic(unsigned field, std::string message)
+{
+  diagnostics.push_back({line_number, field, std::move(message)});
+}
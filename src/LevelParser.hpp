@@ -0,0 +1,119 @@
+/**
+  *   @file LevelParser.hpp
+  *   @brief Header for LevelParser class, the level file parser shared by World and Level
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+
+/**
+  *   @struct LevelRecord
+  *   @brief One entity line of a level file
+  *   @details Format: entity type;x;y;orientation;width;height
+  *   @remark type is a view into the LevelParser buffer, it is valid only as
+  *   long as the parser isn't destroyed or given new content
+  */
+struct LevelRecord
+{
+  std::string_view type; /**< Entity type, e.g. BlueAirplane */
+  double x = 0; /**< Upper left corner x coordinate */
+  double y = 0; /**< Upper left corner y coordinate */
+  int orientation = 1; /**< 1 for left -> right, 0 for right -> left */
+  double width = 0; /**< Entity width */
+  double height = 0; /**< Entity height */
+  unsigned line = 0; /**< Line number in the level file (starts from 1) */
+};
+
+/**
+  *   @struct LevelDiagnostic
+  *   @brief Describes why a level file line couldn't be parsed
+  */
+struct LevelDiagnostic
+{
+  unsigned line; /**< Line number in the level file (0 if the file itself failed) */
+  unsigned field; /**< Index of the failed field (0 - 5) */
+  std::string message; /**< Human readable description */
+};
+
+/**
+  *   @class LevelParser
+  *   @brief Streaming parser for level files
+  *   @details Reads the whole level file to one buffer and hands out one
+  *   LevelRecord at a time. Numbers are parsed with std::from_chars, so parsing
+  *   doesn't allocate or throw. Errors are reported as LevelDiagnostics.
+  *   @remark See plan/level_format.txt for the file format
+  */
+class LevelParser
+{
+  public:
+
+    /**
+      *   @brief Read level file to the parser buffer
+      *   @param filename Path to the level file
+      *   @return Returns false if the file couldn't be read
+      */
+    bool open(const std::string& filename);
+
+    /**
+      *   @brief Use given string as level file content
+      *   @param content Whole level file content
+      */
+    void setContent(std::string content);
+
+    /**
+      *   @brief Parse next entity line
+      *   @details Level name and description (ending to the comment end mark) are skipped,
+      *   as are empty lines
+      *   @param record Filled with the parsed line
+      *   @return Returns false when the content has ended or a line is malformed,
+      *   use failed() to tell these apart
+      */
+    bool next(LevelRecord& record);
+
+    /**
+      *   @return Returns true if a line was malformed or the file couldn't be read
+      */
+    bool failed() const;
+
+    /**
+      *   @return Returns all diagnostics collected so far
+      */
+    const std::vector<LevelDiagnostic>& getDiagnostics() const;
+
+    /**
+      *   @brief Print diagnostics, one per line
+      *   @param os Output stream
+      *   @param filename Level file name used as message prefix
+      */
+    void printDiagnostics(std::ostream& os, const std::string& filename) const;
+
+  private:
+
+    /**
+      *   @brief Parse one entity line
+      *   @param line Line without line feed
+      *   @param record Filled with the parsed fields
+      *   @return Returns false and adds a diagnostic if the line is malformed
+      */
+    bool ParseLine(std::string_view line, LevelRecord& record);
+
+    /**
+      *   @brief Add diagnostic for the current line
+      *   @param field Failed field index
+      *   @param message Description
+      */
+    void AddDiagnostic(unsigned field, std::string message);
+
+    /*  Variables */
+    std::string buffer; /**< Whole level file */
+    std::size_t position = 0; /**< Start of the next unread line in buffer */
+    unsigned line_number = 0; /**< Number of the last read line */
+    bool comments_read = false; /**< True after the description end mark */
+    std::vector<LevelDiagnostic> diagnostics;
+};
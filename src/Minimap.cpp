@@ -0,0 +1,159 @@
+/**
+  *   @file Minimap.cpp
+  *   @brief Source code for class Minimap
+  */
+
+#include "Minimap.hpp"
+#include <algorithm>
+#include <cmath>
+
+/*  Member Initializations */
+const int Minimap::COLUMNS = 240;
+const int Minimap::ROWS = 40;
+const int Minimap::IMAGE_INTERVAL = 6;
+
+namespace
+{
+  const sf::Color EMPTY(20, 30, 50, 160);
+  const sf::Color GROUND(110, 90, 60, 220);
+  const sf::Color BLUE(70, 140, 255);
+  const sf::Color RED(255, 70, 60);
+  const sf::Color CONTESTED(230, 120, 255); /**< Both teams in the cell */
+}
+
+Minimap::Minimap()
+{
+  reset(sf::Vector2f(Game::WIDTH, Game::HEIGHT));
+}
+
+void Minimap::reset(const sf::Vector2f& size)
+{
+  level_size = sf::Vector2f(std::max(size.x, 1.f), std::max(size.y, 1.f));
+  cell_size = sf::Vector2f(level_size.x / COLUMNS, level_size.y / ROWS);
+  counts.assign(COLUMNS * ROWS * 2, 0);
+  ground.assign(COLUMNS * ROWS, false);
+  image.reset();
+  changed = true;
+  image_tick = 0;
+}
+
+void Minimap::addGround(const sf::FloatRect& area)
+{
+  int first = getCell(sf::Vector2f(area.left, area.top));
+  int last = getCell(sf::Vector2f(area.left + area.width, area.top + area.height));
+  for (int row = first / COLUMNS; row <= last / COLUMNS; row++)
+  {
+    for (int column = first % COLUMNS; column <= last % COLUMNS; column++)
+    {
+      ground[row * COLUMNS + column] = true;
+    }
+  }
+  changed = true;
+}
+
+int Minimap::Layer(Game::TEAM_ID team)
+{
+  switch (team)
+  {
+    case Game::TEAM_ID::blue:
+      return 0;
+    case Game::TEAM_ID::red:
+      return 1;
+    default:
+      return -1;
+  }
+}
+
+int Minimap::getCell(const sf::Vector2f& position) const
+{
+  int column = static_cast<int>(std::floor(position.x / cell_size.x));
+  int row = static_cast<int>(std::floor(position.y / cell_size.y));
+  column = std::max(0, std::min(column, COLUMNS - 1));
+  row = std::max(0, std::min(row, ROWS - 1));
+  return row * COLUMNS + column;
+}
+
+int Minimap::insert(Game::TEAM_ID team, const sf::Vector2f& position)
+{
+  int layer = Layer(team);
+  if (layer < 0)
+  {
+    return -1;
+  }
+  int cell = getCell(position);
+  counts[cell * 2 + layer]++;
+  changed = true;
+  return cell;
+}
+
+int Minimap::move(int cell, Game::TEAM_ID team, const sf::Vector2f& position)
+{
+  if (cell < 0)
+  {
+    return insert(team, position);
+  }
+  int next = getCell(position);
+  if (next != cell)
+  {
+    int layer = Layer(team);
+    counts[cell * 2 + layer]--;
+    counts[next * 2 + layer]++;
+    changed = true;
+  }
+  return next;
+}
+
+void Minimap::remove(int cell, Game::TEAM_ID team)
+{
+  int layer = Layer(team);
+  if (cell < 0 || layer < 0)
+  {
+    return;
+  }
+  counts[cell * 2 + layer]--;
+  changed = true;
+}
+
+std::shared_ptr<const MinimapImage> Minimap::getImage(long tick)
+{
+  if (! image || (changed && tick - image_tick >= IMAGE_INTERVAL))
+  {
+    MakeImage();
+    image_tick = tick;
+  }
+  return image;
+}
+
+void Minimap::MakeImage()
+{
+  // Render thread may still draw the previous image, it is released with its last frame
+  auto next = std::make_shared<MinimapImage>();
+  next->size = sf::Vector2u(COLUMNS, ROWS);
+  next->level_size = level_size;
+  next->pixels.resize(COLUMNS * ROWS * 4);
+  sf::Uint8* pixel = next->pixels.data();
+  for (int cell = 0; cell < COLUMNS * ROWS; cell++, pixel += 4)
+  {
+    bool blue = counts[cell * 2] > 0;
+    bool red = counts[cell * 2 + 1] > 0;
+    sf::Color color = blue && red ? CONTESTED : blue ? BLUE : red ? RED : ground[cell] ? GROUND : EMPTY;
+    pixel[0] = color.r;
+    pixel[1] = color.g;
+    pixel[2] = color.b;
+    pixel[3] = color.a;
+  }
+  image = std::move(next);
+  changed = false;
+  images++;
+}
+
+int Minimap::getCount(int cell, Game::TEAM_ID team) const
+{
+  int layer = Layer(team);
+  return layer < 0 ? 0 : counts[cell * 2 + layer];
+}
+
+long Minimap::getImageCount() const
+{
+  return images;
+}
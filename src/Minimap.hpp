@@ -0,0 +1,124 @@
+/**
+  *   @file Minimap.hpp
+  *   @brief Header for Minimap class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include "RenderFrame.hpp"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+/**
+  *   @class Minimap
+  *   @brief Coarse occupancy grid of the whole level for the minimap overlay
+  *   @details The level is split into COLUMNS x ROWS cells and every cell
+  *   counts the blue and red units in it. A unit is moved only when it
+  *   crosses to another cell, so a step costs one index calculation per
+  *   moving unit. The grid is turned into a small image at most once per
+  *   IMAGE_INTERVAL steps and only after changes, the render thread uploads
+  *   it as a texture.
+  *   @remark Only blue and red units are counted, ground is marked once per level
+  */
+class Minimap
+{
+  public:
+
+    static const int COLUMNS; /**< Cells along the level width, also the image width */
+    static const int ROWS; /**< Cells along the level height */
+    static const int IMAGE_INTERVAL; /**< Steps between two images at least */
+
+    /**
+      *   @brief Constructor, the level is the window size until reset
+      */
+    Minimap();
+
+    /**
+      *   @brief Remove all units and ground
+      *   @param level_size Level size in pixels, the cells are stretched over it
+      */
+    void reset(const sf::Vector2f& level_size);
+
+    /**
+      *   @brief Mark cells covered by ground
+      *   @param area Ground box in pixels
+      */
+    void addGround(const sf::FloatRect& area);
+
+    /**
+      *   @brief Count a unit
+      *   @param team Team of the unit, other teams than blue and red aren't counted
+      *   @param position Unit center in pixels, clamped to the level
+      *   @return Returns the cell of the unit, -1 if it isn't counted
+      */
+    int insert(Game::TEAM_ID team, const sf::Vector2f& position);
+
+    /**
+      *   @brief Move a unit to the cell of its new position
+      *   @param cell Cell returned for the unit earlier, -1 inserts the unit
+      *   @param team Team of the unit
+      *   @param position New center in pixels
+      *   @return Returns the new cell of the unit
+      */
+    int move(int cell, Game::TEAM_ID team, const sf::Vector2f& position);
+
+    /**
+      *   @brief Stop counting a unit
+      *   @param cell Cell of the unit, -1 is ignored
+      *   @param team Team of the unit
+      */
+    void remove(int cell, Game::TEAM_ID team);
+
+    /**
+      *   @brief Get image of the grid
+      *   @details A new image is made if the grid changed and IMAGE_INTERVAL
+      *   steps passed since the previous one, otherwise the previous image
+      *   is returned
+      *   @param tick Current step
+      *   @return Returns the image, it isn't changed after it is returned
+      */
+    std::shared_ptr<const MinimapImage> getImage(long tick);
+
+    /**
+      *   @param cell Cell index
+      *   @param team Game::TEAM_ID::blue or Game::TEAM_ID::red
+      *   @return Returns the units of a team in a cell
+      */
+    int getCount(int cell, Game::TEAM_ID team) const;
+
+    /**
+      *   @param position Position in pixels, clamped to the level
+      *   @return Returns the cell index of a position
+      */
+    int getCell(const sf::Vector2f& position) const;
+
+    /**
+      *   @return Returns the amount of images made
+      */
+    long getImageCount() const;
+
+  private:
+
+    /**
+      *   @return Returns the count layer of a team, -1 for teams not counted
+      */
+    static int Layer(Game::TEAM_ID team);
+
+    /**
+      *   @brief Make a new image of the grid
+      */
+    void MakeImage();
+
+    sf::Vector2f level_size;
+    sf::Vector2f cell_size; /**< Pixels per cell */
+    std::vector<int> counts; /**< Blue and red units, two per cell */
+    std::vector<bool> ground; /**< Cells covered by ground */
+    std::shared_ptr<const MinimapImage> image; /**< Latest image, shared with the render thread */
+    bool changed = true; /**< Grid changed after the latest image */
+    long image_tick = 0; /**< Step of the latest image */
+    long images = 0;
+};
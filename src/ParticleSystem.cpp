@@ -0,0 +1,215 @@
+/**
+  *   @file ParticleSystem.cpp
+  *   @brief Source code for class ParticleSystem
+  */
+
+#include "ParticleSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/*  Member Initializations */
+const std::size_t ParticleSystem::DEFAULT_CAPACITY = 4096;
+const int ParticleSystem::DEFAULT_STEP_BUDGET = 512;
+
+namespace
+{
+  /**
+    *   @brief Emitted particles of one effect
+    */
+  struct EffectSpec
+  {
+    int count;
+    float min_speed; /**< Pixels per second */
+    float max_speed;
+    float spread; /**< Radians around the direction, 2 pi is all around */
+    float min_lifetime; /**< Seconds */
+    float max_lifetime;
+    float size; /**< Pixels */
+    float gravity; /**< Pixels per second squared */
+    float drag; /**< Share of velocity kept per second */
+    sf::Color first; /**< Colors are mixed between these */
+    sf::Color second;
+  };
+
+  const float PI = 3.14159265f;
+
+  const EffectSpec EFFECTS[ParticleSystem::effect_end] = {
+    // count, speed, spread, lifetime, size, gravity, drag, colors
+    { 40, 30.f, 160.f, 2 * PI, 0.4f, 1.0f, 3.f, 60.f, 0.2f, sf::Color(255, 210, 60), sf::Color(200, 40, 10) },
+    { 80, 40.f, 240.f, 2 * PI, 0.5f, 1.2f, 4.f, 80.f, 0.15f, sf::Color(255, 230, 120), sf::Color(90, 80, 70) },
+    { 4, 40.f, 120.f, 0.6f, 0.05f, 0.12f, 2.f, 0.f, 0.01f, sf::Color(255, 250, 180), sf::Color(255, 170, 40) },
+  };
+
+  /*  SIMD kernels, four particles per lane vector  */
+
+  using Lanes = float __attribute__((vector_size(16)));
+  const std::size_t LANES = 4;
+
+  inline Lanes Load(const float* source)
+  {
+    Lanes value;
+    std::memcpy(&value, source, sizeof value);
+    return value;
+  }
+
+  inline void Store(float* target, Lanes value)
+  {
+    std::memcpy(target, &value, sizeof value);
+  }
+
+  std::size_t Padded(std::size_t count)
+  {
+    return (count + LANES - 1) / LANES * LANES;
+  }
+
+  // position += velocity * dt, previous position is kept for interpolation
+  void Integrate(float* position, float* previous, const float* velocity, std::size_t count, float time_step)
+  {
+    const Lanes dt = Lanes{} + time_step;
+    for (std::size_t i = 0; i < count; i += LANES)
+    {
+      Lanes current = Load(position + i);
+      Store(previous + i, current);
+      Store(position + i, current + Load(velocity + i) * dt);
+    }
+  }
+
+  // velocity *= kept share of the step, vertical velocity gains gravity
+  void Accelerate(float* vx, float* vy, const float* gravity, const float* drag, std::size_t count, float time_step)
+  {
+    const Lanes dt = Lanes{} + time_step;
+    const Lanes one = Lanes{} + 1.f;
+    for (std::size_t i = 0; i < count; i += LANES)
+    {
+      // linear approximation of drag^dt, exact enough for one short step
+      Lanes keep = one - (one - Load(drag + i)) * dt;
+      Store(vx + i, Load(vx + i) * keep);
+      Store(vy + i, Load(vy + i) * keep + Load(gravity + i) * dt);
+    }
+  }
+
+  void Age(float* age, std::size_t count, float time_step)
+  {
+    const Lanes dt = Lanes{} + time_step;
+    for (std::size_t i = 0; i < count; i += LANES)
+    {
+      Store(age + i, Load(age + i) + dt);
+    }
+  }
+}
+
+ParticleSystem::ParticleSystem(std::size_t capacity, int step_budget)
+  : limit(capacity), step_budget(step_budget), budget_left(step_budget)
+{
+  // Kernels may run over the last live particle to the end of its lane
+  const std::size_t padded = Padded(capacity);
+  for (std::vector<float>* array : {&x, &y, &previous_x, &previous_y, &vx, &vy, &gravity, &drag, &age, &lifetime, &side})
+  {
+    array->assign(padded, 0.f);
+  }
+  color.assign(padded, sf::Color::Transparent);
+}
+
+float ParticleSystem::Random()
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return (seed & 0xFFFFFF) / static_cast<float>(0x1000000);
+}
+
+void ParticleSystem::emit(Effect effect, sf::Vector2f position, sf::Vector2f direction)
+{
+  const EffectSpec& spec = EFFECTS[effect];
+  int wanted = spec.count;
+  int allowed = std::max(0, std::min(wanted, budget_left));
+  allowed = static_cast<int>(std::min<std::size_t>(allowed, limit - count));
+  dropped += wanted - allowed;
+  budget_left -= allowed;
+
+  const float heading = std::atan2(direction.y, direction.x);
+  for (int n = 0; n < allowed; n++, count++)
+  {
+    float angle = heading + (Random() - 0.5f) * spec.spread;
+    float speed = spec.min_speed + (spec.max_speed - spec.min_speed) * Random();
+    float mix = Random();
+    x[count] = previous_x[count] = position.x;
+    y[count] = previous_y[count] = position.y;
+    vx[count] = std::cos(angle) * speed;
+    vy[count] = std::sin(angle) * speed;
+    gravity[count] = spec.gravity;
+    drag[count] = spec.drag;
+    age[count] = 0.f;
+    lifetime[count] = spec.min_lifetime + (spec.max_lifetime - spec.min_lifetime) * Random();
+    side[count] = spec.size;
+    color[count] = sf::Color(spec.first.r + (spec.second.r - spec.first.r) * mix,
+                             spec.first.g + (spec.second.g - spec.first.g) * mix,
+                             spec.first.b + (spec.second.b - spec.first.b) * mix);
+  }
+}
+
+void ParticleSystem::step(float time_step)
+{
+  budget_left = step_budget;
+  const std::size_t lanes = Padded(count);
+  Age(age.data(), lanes, time_step);
+  Accelerate(vx.data(), vy.data(), gravity.data(), drag.data(), lanes, time_step);
+  Integrate(x.data(), previous_x.data(), vx.data(), lanes, time_step);
+  Integrate(y.data(), previous_y.data(), vy.data(), lanes, time_step);
+
+  // Move the last particle to the place of an expired one
+  for (std::size_t i = 0; i < count; )
+  {
+    if (age[i] < lifetime[i])
+    {
+      i++;
+      continue;
+    }
+    std::size_t last = --count;
+    x[i] = x[last];
+    y[i] = y[last];
+    previous_x[i] = previous_x[last];
+    previous_y[i] = previous_y[last];
+    vx[i] = vx[last];
+    vy[i] = vy[last];
+    gravity[i] = gravity[last];
+    drag[i] = drag[last];
+    age[i] = age[last];
+    lifetime[i] = lifetime[last];
+    side[i] = side[last];
+    color[i] = color[last];
+  }
+}
+
+void ParticleSystem::exportState(std::vector<ParticleState>& states) const
+{
+  for (std::size_t i = 0; i < count; i++)
+  {
+    sf::Color faded = color[i];
+    faded.a = static_cast<sf::Uint8>(255.f * (1.f - age[i] / lifetime[i]));
+    states.push_back(ParticleState{sf::Vector2f(previous_x[i], previous_y[i]), sf::Vector2f(x[i], y[i]), side[i], faded});
+  }
+}
+
+void ParticleSystem::clear()
+{
+  count = 0;
+  budget_left = step_budget;
+  dropped = 0;
+}
+
+std::size_t ParticleSystem::size() const
+{
+  return count;
+}
+
+std::size_t ParticleSystem::capacity() const
+{
+  return limit;
+}
+
+long ParticleSystem::getDroppedCount() const
+{
+  return dropped;
+}
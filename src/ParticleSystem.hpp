@@ -0,0 +1,121 @@
+/**
+  *   @file ParticleSystem.hpp
+  *   @brief Header for ParticleSystem class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "RenderFrame.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+  *   @class ParticleSystem
+  *   @brief Short lived visual particles of explosions and shots
+  *   @details Particles are stored as parallel arrays in a pool whose
+  *   capacity is fixed at construction, so emitting never allocates. The
+  *   arrays are padded to whole SIMD lanes and updated four particles at a
+  *   time. Emitting is limited to a budget per step: a chain of explosions
+  *   drops particles instead of exceeding it.
+  *   @remark Particles don't collide, they are only drawn
+  */
+class ParticleSystem
+{
+  public:
+
+    /**
+      *   @brief Particle effects, see EFFECTS in ParticleSystem.cpp
+      */
+    enum Effect
+    {
+      explosion, /**< Destroyed entity */
+      bomb_blast, /**< Bomb detonation */
+      muzzle_flash, /**< Fired projectile */
+      effect_end
+    };
+
+    static const std::size_t DEFAULT_CAPACITY; /**< Live particles at most */
+    static const int DEFAULT_STEP_BUDGET; /**< Particles emitted per step at most */
+
+    /**
+      *   @brief Constructor, allocates the whole pool
+      *   @param capacity Live particles at most
+      *   @param step_budget Particles emitted per step at most
+      */
+    explicit ParticleSystem(std::size_t capacity = DEFAULT_CAPACITY, int step_budget = DEFAULT_STEP_BUDGET);
+
+    /**
+      *   @brief Emit the particles of an effect
+      *   @details Particles over the step budget or the capacity are dropped
+      *   @param effect Effect to be emitted
+      *   @param position Center in pixels
+      *   @param direction Unit vector the particles are thrown to, ignored by
+      *   effects that spread all around
+      */
+    void emit(Effect effect, sf::Vector2f position, sf::Vector2f direction = sf::Vector2f(0.f, -1.f));
+
+    /**
+      *   @brief Move all particles one step and remove the expired ones
+      *   @details Refills the emit budget
+      *   @param time_step Step length in seconds
+      */
+    void step(float time_step);
+
+    /**
+      *   @brief Copy particle quads for the render thread
+      *   @param states Particles are appended
+      */
+    void exportState(std::vector<ParticleState>& states) const;
+
+    /**
+      *   @brief Remove all particles and reset counters, capacity is kept
+      */
+    void clear();
+
+    /**
+      *   @return Returns the amount of live particles
+      */
+    std::size_t size() const;
+
+    /**
+      *   @return Returns the amount of particles the pool can hold
+      */
+    std::size_t capacity() const;
+
+    /**
+      *   @return Returns the amount of particles dropped by the budget or the capacity
+      */
+    long getDroppedCount() const;
+
+  private:
+
+    /**
+      *   @return Returns a random number 0...1
+      */
+    float Random();
+
+    std::size_t count = 0; /**< Live particles, they are the first count elements */
+    std::size_t limit; /**< Capacity */
+    int step_budget;
+    int budget_left; /**< Particles that can still be emitted this step */
+    long dropped = 0;
+    std::uint32_t seed = 2463534242u; /**< Xorshift state */
+
+    /*  Particle state, one element per particle, padded to whole lanes  */
+    std::vector<float> x; /**< Position in pixels */
+    std::vector<float> y;
+    std::vector<float> previous_x; /**< Position before the last step */
+    std::vector<float> previous_y;
+    std::vector<float> vx; /**< Velocity in pixels per second */
+    std::vector<float> vy;
+    std::vector<float> gravity; /**< Acceleration down in pixels per second squared */
+    std::vector<float> drag; /**< Share of velocity kept per second */
+    std::vector<float> age; /**< Seconds since emitted */
+    std::vector<float> lifetime; /**< Seconds the particle lives */
+    std::vector<float> side; /**< Quad side in pixels */
+    std::vector<sf::Color> color; /**< Color at birth, fades out over the lifetime */
+};
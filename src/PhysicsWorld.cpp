@@ -1,85 +1,110 @@
 #include "PhysicsWorld.hpp"
+#include <vector>
 PhysicsWorld::PhysicsWorld() {
-    b2Vec2 gvector(0.0f, Game::GRAVITY);
-	World = new b2World(gvector);
+	reset();
 }
 
-b2Body* PhysicsWorld::create_body_dynamic(double x, double y, double width, double height, int density) {
+void PhysicsWorld::reset() {
+	b2Vec2 gvector(0.0f, Game::GRAVITY);
+	World.reset(new b2World(gvector));
+	collision_group = 0;
+}
+
+b2Body* PhysicsWorld::create_body(const Units::Prototype& prototype, double x, double y, double width, double height) {
 	//creating a definition of a body
 	b2BodyDef BodyDef;
-	BodyDef.type = b2_dynamicBody; //creating a dynamic body
+	BodyDef.type = prototype.body;
 	BodyDef.position = b2Vec2((x)/Game::TOPIXELS, (y)/Game::TOPIXELS); //set initial position (meters, not pixels)
 	BodyDef.angle = 0; //set initial angle (radians)
+	BodyDef.gravityScale = prototype.gravity_scale;
 
 	//creating a body
 	b2Body* Body = World->CreateBody(&BodyDef);
+	if (prototype.shape == Units::terrain) {
+		// no fixtures, so no broadphase proxies
+		return Body;
+	}
 
 	//creating fixture to an "invisible" body
 	b2PolygonShape boxShape; //hitbox that has a shape of a box
-	boxShape.SetAsBox((width/2)/Game::TOPIXELS, (height/2)/Game::TOPIXELS); 
+	boxShape.SetAsBox((width/2)/Game::TOPIXELS, (height/2)/Game::TOPIXELS);
 
 	b2FixtureDef FixtureDef;
 	FixtureDef.shape = &boxShape;
-	FixtureDef.density = density; //mass of the body is AREA * density
-	FixtureDef.filter.categoryBits = 0x0004; //id of dynamic body
+	FixtureDef.density = prototype.density; //mass of the body is AREA * density
+	Collision::Bits bits = Collision::getBits(Collision::solidKind(prototype.type), prototype.team);
+	FixtureDef.filter.categoryBits = bits.category;
+	FixtureDef.filter.maskBits = bits.mask;
+	if (prototype.bullets > 0 || prototype.bombs > 0) {
+		// own bullets share the group and never touch their shooter
+		FixtureDef.filter.groupIndex = next_collision_group();
+	}
 	Body->CreateFixture(&FixtureDef);
 
-	//sensor
-	b2CircleShape radarshape;
-	b2FixtureDef radar;
-	radarshape.m_radius = 20; //radius of the sensor
-	radar.shape = &radarshape;
-	radar.isSensor = true;
-	radar.filter.categoryBits = 0x0002; //id for sensors
-	radar.filter.maskBits = 0x0004; //make radar only detect dynamic bodies
-
-	Body->CreateFixture(&radar);
+	if (prototype.sensor_radius > 0) {
+		b2CircleShape radarshape;
+		b2FixtureDef radar;
+		radarshape.m_radius = prototype.sensor_radius;
+		radar.shape = &radarshape;
+		radar.isSensor = true;
+		bits = Collision::getBits(prototype.type == Game::TYPE_ID::antiaircraft ? Collision::aa_radar : Collision::radar, prototype.team);
+		radar.filter.categoryBits = bits.category;
+		radar.filter.maskBits = bits.mask;
+		radar.filter.groupIndex = FixtureDef.filter.groupIndex;
+		Body->CreateFixture(&radar);
+	}
 
-	return Body; 
+	return Body;
 }
 
-b2Body* PhysicsWorld::create_body_static(double x, double y, double width, double height, Game::TYPE_ID type) {
+b2Body* PhysicsWorld::create_body_terrain() {
 	b2BodyDef BodyDef;
 	BodyDef.type = b2_staticBody;
-	BodyDef.position = b2Vec2((x)/Game::TOPIXELS, (y)/Game::TOPIXELS);
-
-	b2Body* Body = World->CreateBody(&BodyDef);
+	BodyDef.position = b2Vec2(0.f, 0.f);
+	return World->CreateBody(&BodyDef);
+}
 
+b2Fixture* PhysicsWorld::add_terrain_box(b2Body* body, const TerrainRect& rect) {
 	b2PolygonShape Shape;
-	Shape.SetAsBox((width/2)/Game::TOPIXELS, (height/2)/Game::TOPIXELS); 
+	b2Vec2 center((rect.left + rect.width/2)/Game::TOPIXELS, (rect.top + rect.height/2)/Game::TOPIXELS);
+	Shape.SetAsBox((rect.width/2)/Game::TOPIXELS, (rect.height/2)/Game::TOPIXELS, center, 0.f);
 
 	b2FixtureDef FixtureDef;
 	FixtureDef.density = 0.f;
 	FixtureDef.shape = &Shape;
-	if (type == Game::TYPE_ID::antiaircraft || type == Game::TYPE_ID::base || type == Game::TYPE_ID::hangar || type == Game::TYPE_ID::rock || type == Game::TYPE_ID::tree)
-	  {
-	    FixtureDef.filter.categoryBits = 0x0004;
-	  }
-	Body->CreateFixture(&FixtureDef);
-
-	return Body;
+	FixtureDef.filter = terrain_filter();
+	return body->CreateFixture(&FixtureDef);
 }
 
-b2Body* PhysicsWorld::create_body_bullet(double x, double y, double width, double height) {
-	b2BodyDef BodyDef;
-	BodyDef.type = b2_staticBody;
-	BodyDef.position = b2Vec2((x)/Game::TOPIXELS, (y)/Game::TOPIXELS);
-	BodyDef.bullet = true;
-	BodyDef.active = false;
-
-	b2Body* Body = World->CreateBody(&BodyDef);
-
-	b2PolygonShape Shape;
-	Shape.SetAsBox((width/2)/Game::TOPIXELS, (height/2)/Game::TOPIXELS); 
+b2Fixture* PhysicsWorld::add_terrain_loop(b2Body* body, const TerrainLoop& loop) {
+	std::vector<b2Vec2> vertices;
+	vertices.reserve(loop.size());
+	for (const TerrainPoint& point : loop) {
+		vertices.emplace_back(point.x/Game::TOPIXELS, point.y/Game::TOPIXELS);
+	}
+	// edges of a loop are connected, so bodies don't catch on internal corners
+	b2ChainShape Shape;
+	Shape.CreateLoop(vertices.data(), static_cast<int32>(vertices.size()));
 
 	b2FixtureDef FixtureDef;
 	FixtureDef.density = 0.f;
 	FixtureDef.shape = &Shape;
-	FixtureDef.filter.categoryBits = 0x0008;
-	FixtureDef.filter.maskBits = 0x0002;
-	Body->CreateFixture(&FixtureDef);
+	FixtureDef.filter = terrain_filter();
+	return body->CreateFixture(&FixtureDef);
+}
 
-	return Body;
+b2Filter PhysicsWorld::terrain_filter() {
+	b2Filter filter;
+	Collision::Bits bits = Collision::getBits(Collision::terrain);
+	filter.categoryBits = bits.category;
+	filter.maskBits = bits.mask;
+	return filter;
+}
+
+int16 PhysicsWorld::next_collision_group() {
+	// negative groups never collide within the group, wrap before int16 runs out
+	collision_group = collision_group <= -32767 ? -1 : collision_group - 1;
+	return collision_group;
 }
 
 void PhysicsWorld::remove_body(b2Body* body) {
@@ -87,9 +112,7 @@ void PhysicsWorld::remove_body(b2Body* body) {
 }
 
 b2World* PhysicsWorld::get_world() {
-	return World;
+	return World.get();
 }
 
-PhysicsWorld::~PhysicsWorld() {
-	delete World;
-}
+PhysicsWorld::~PhysicsWorld() = default;
@@ -7,7 +7,11 @@
 
 /*  Includes  */
 #include "CommonDefinitions.hpp"
+#include "TerrainOutline.hpp"
+#include "CollisionFilter.hpp"
+#include "UnitPrototypes.hpp"
 #include <Box2D/Box2D.h>
+#include <memory>
 
 /**
   *   @class PhysicsWorld
@@ -28,42 +32,69 @@ public:
 	~PhysicsWorld();
 
   /**
-   *   @brief Creates a dynamic body
-   *   @param x X-position where new body is created
-   *   @param y Y-position where new body is created
-   *   @param width Width of the body
-   *   @param height Height of the body
-	 *   @param density Density of the body (affects mass of the body)
-   *   @return Created body
+   *   @brief Replace the Box2D world with an empty one
+   *   @details Deleting the b2World frees its fixtures in one pass and the
+   *   block allocator wholesale, without removing proxies and contacts body
+   *   by body like DestroyBody. Pointers from get_world become invalid.
    */
-       b2Body* create_body_dynamic(double x, double y, double width, double height, int density);
+	void reset();
 
   /**
-   *   @brief Creates a static body
+   *   @brief Creates the body of a unit prototype
+   *   @details Body type, density, gravity scale and radar sensor come from
+   *   the prototype. Shooting units get their own collision group, see
+   *   next_collision_group. Units::terrain prototypes get a body without
+   *   fixtures, their box is merged to the terrain body.
+   *   @param prototype Unit prototype
    *   @param x X-position where new body is created
    *   @param y Y-position where new body is created
    *   @param width Width of the body
    *   @param height Height of the body
-	 *   @param type Static body type @see CommonDefinitions
    *   @return Created body
    */
-        b2Body* create_body_static(double x, double y, double width, double height, Game::TYPE_ID type);
+        b2Body* create_body(const Units::Prototype& prototype, double x, double y, double width, double height);
 
   /**
-   *   @brief Removes a body
-   *   @param body Body to be removed
+   *   @brief Creates a static body for merged terrain
+   *   @details Fixtures are added with add_terrain_box and add_terrain_loop
+   *   @return Created body at the origin
    */
-	void remove_body(b2Body* body);
+        b2Body* create_body_terrain();
 
   /**
-   *   @brief Creates a bullet
-   *   @param x X-position where new body is created
-   *   @param y Y-position where new body is created
-   *   @param width Width of the body
-   *   @param height Height of the body
-   *   @return Created bullet
+   *   @brief Adds a box fixture to the terrain body
+   *   @param body Terrain body
+   *   @param rect Box in pixels
+   *   @return Created fixture
    */
-	b2Body* create_body_bullet(double x, double y, double width, double height);
+        b2Fixture* add_terrain_box(b2Body* body, const TerrainRect& rect);
+
+  /**
+   *   @brief Adds a chain loop fixture to the terrain body
+   *   @param body Terrain body
+   *   @param loop Outline in pixels
+   *   @return Created fixture
+   */
+        b2Fixture* add_terrain_loop(b2Body* body, const TerrainLoop& loop);
+
+  /**
+   *   @return Returns filter of the terrain fixtures
+   */
+        static b2Filter terrain_filter();
+
+  /**
+   *   @brief Get a new collision group for a shooter
+   *   @details Fixtures with the same negative group index never collide, the
+   *   bullets of an entity copy the group of its body
+   *   @return Returns negative group index
+   */
+        int16 next_collision_group();
+
+  /**
+   *   @brief Removes a body
+   *   @param body Body to be removed
+   */
+	void remove_body(b2Body* body);
 
   /**
    *   @brief Gets the world of PhysicsWorld
@@ -77,5 +108,6 @@ public:
 	void move();
 
 private:
-	b2World* World; /**< World of PhysicsWorld */
+	std::unique_ptr<b2World> World; /**< World of PhysicsWorld */
+	int16 collision_group = 0; /**< Last collision group given by next_collision_group */
 };
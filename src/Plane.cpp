@@ -2,13 +2,7 @@
 #include "CommonDefinitions.hpp"
 #include <cmath>
 
-const int bullet_correction = 5;  // this is how many pixels away from the body bullet is created
-const float bullet_force = 1000;  // this is multiplier for impulse given to bullet
-
-
-Plane::Plane(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position, sf::Vector2f direct, Game::TEAM_ID team):Entity(w, b, t, position, 20, 400, 6, 20, 20, direct, team){
-  typeId = Game::TYPE_ID::airplane;
-  }
+Plane::Plane(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype) : Entity(w, b, t, position, prototype) {}
 
 
 
@@ -63,56 +57,26 @@ void Plane::moveRight()
 }
 
 
-bool Plane::shoot(sf::Vector2f direction, ResourceManager & resources){
-
-  if (clock.getElapsedTime()>sf::seconds(0.5f)) {
-        if (numberOfBullets > 0) {
-          numberOfBullets-=1;
-
-          double x, y;
-
-          if (getFacing()) {
-            x = getPosition().x + (this->getSize().x)/2*cos(this->getB2Body()->GetAngle()) + bullet_correction;
-            y = getPosition().y + (this->getSize().y)/2*sin(this->getB2Body()->GetAngle());
-          }
-          else {
-            x = getPosition().x - (this->getSize().x)/2*cos(this->getB2Body()->GetAngle()) - bullet_correction;
-            y = getPosition().y - (this->getSize().y)/2*sin(this->getB2Body()->GetAngle());
-          }
-
-          sf::Texture &tex = resources.get(Textures::alphaTextures.at("Bullet"));
-
-          b2BodyDef BodyDef;
-          BodyDef.type = b2_dynamicBody;
-
-          BodyDef.position = b2Vec2(x*Game::TOMETERS, y*Game::TOMETERS);
-          BodyDef.bullet = true;
-
-          b2Body* body = world.CreateBody(&BodyDef);
-
-          b2PolygonShape Shape;
-          Shape.SetAsBox(((this->getSize().x)/2)/Game::TOPIXELS, ((this->getSize().y)/2)/Game::TOPIXELS);
-
-          b2FixtureDef FixtureDef;
-          FixtureDef.density = 0.f;
-          FixtureDef.shape = &Shape;
-          FixtureDef.filter.categoryBits = 0x0008;
-          body->CreateFixture(&FixtureDef);
-
-          sf::Vector2f pos(x,y);
-          std::shared_ptr<Entity> bullet = std::make_shared<Bullet>(world, body, tex, pos, sf::Vector2f(1.0f, 0.0f), this);
-          bullet->setType(Textures::Bullet_alpha);
-
-          body->SetGravityScale(0.5f);
-          body->ApplyLinearImpulse(b2Vec2(direction.x*bullet_force, direction.y*bullet_force), body->GetWorldCenter(), true);
-          body->SetUserData(bullet.get());
-          active_bullets.push_back(bullet);
-
-          clock.restart();
-          return true;
-        }
+bool Plane::shoot(sf::Vector2f direction){
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[Weapons::plane_gun];
+  sf::Vector2f pos;
+  // Projectile leaves from the nose of the plane
+  if (getFacing()) {
+    pos.x = getPosition().x + (this->getSize().x)/2*cos(this->getB2Body()->GetAngle()) + spec.muzzle_offset;
+    pos.y = getPosition().y + (this->getSize().y)/2*sin(this->getB2Body()->GetAngle());
   }
-    return false;
+  else {
+    pos.x = getPosition().x - (this->getSize().x)/2*cos(this->getB2Body()->GetAngle()) - spec.muzzle_offset;
+    pos.y = getPosition().y - (this->getSize().y)/2*sin(this->getB2Body()->GetAngle());
+  }
+  return fireProjectile(Weapons::plane_gun, pos, direction);
+}
+
+bool Plane::dropBomb(){
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[Weapons::bomb];
+  // Bomb leaves from the belly of the plane
+  sf::Vector2f pos(getPosition().x, getPosition().y + (this->getSize().y)/2 + spec.height/2 + spec.muzzle_offset);
+  return fireProjectile(Weapons::bomb, pos, sf::Vector2f(0.f, 1.f));
 }
 
 void Plane::addToKillList(Entity* killed_entity)
@@ -120,15 +84,11 @@ void Plane::addToKillList(Entity* killed_entity)
   if ( Entity::getTeamId() != killed_entity->getTeamId() )
   {
     kill_list[killed_entity->getTypeId()]++;
+    total_kills++;
   }
 }
 
 int Plane::getGrandTotalKill()
 {
-  int sum = 0;
-  for (auto const & entity : kill_list)
-  {
-    sum += entity.second;
-  }
-  return sum;
+  return total_kills;
 }
@@ -10,7 +10,6 @@
 #include "Entity.hpp"
 #include <Box2D/Box2D.h>
 #include "ResourceManager.hpp"
-#include "Bullet.hpp"
 /**
   *   @class Plane
   *   @brief Entity based planes
@@ -28,10 +27,9 @@ class Plane : public Entity {
    *   @param b Planes body for collisions
    *   @param t Planes texture
    *   @param position Place as vector where Plane is created
-   *   @param direct Direction where plane is headed
-   *   @param team Team where plane belongs to
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Plane(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, sf::Vector2f direct, Game::TEAM_ID team);
+  Plane(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 
   virtual void moveUp() override;
 
@@ -46,9 +44,20 @@ class Plane : public Entity {
    *   @brief give permission for object to shoot
    *   @return Return true or false based on if the object can shoot or not
    */
-  virtual bool shoot(sf::Vector2f direction, ResourceManager & resources) override;
+  virtual bool shoot(sf::Vector2f direction) override;
+
+  /**
+   *   @brief Drop a bomb below the plane
+   *   @return Returns true if a bomb was dropped
+   */
+  virtual bool dropBomb() override;
 
   void addToKillList(Entity* killed_entity);
+
+  /**
+   *   @return Returns the amount of enemies killed, kept as a running total
+   */
   int getGrandTotalKill();
   std::map<Game::TYPE_ID, int> kill_list;
+  int total_kills = 0; /**< Sum of kill_list */
 };
@@ -0,0 +1,255 @@
+/**
+  *   @file ProjectileSystem.cpp
+  *   @brief Source code for class ProjectileSystem
+  */
+
+#include "ProjectileSystem.hpp"
+#include "CollisionFilter.hpp"
+#include <algorithm>
+#include <cmath>
+
+/*  Member Initializations */
+const int ProjectileSystem::LIFETIME_TICKS = 4 * 60; // 4 seconds at 60 updates per second
+
+namespace
+{
+  /**
+    *   @class ProjectileRayCast
+    *   @brief Finds the closest solid fixture a projectile may hit
+    */
+  class ProjectileRayCast : public b2RayCastCallback
+  {
+    public:
+      explicit ProjectileRayCast(int16 owner_group) : group(owner_group), bits(Collision::getBits(Collision::projectile)) {}
+
+      float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& /*normal*/, float32 fraction) override
+      {
+        const b2Filter& filter = fixture->GetFilterData();
+        if (fixture->IsSensor() || (group != 0 && filter.groupIndex == group)
+            || (filter.categoryBits & bits.mask) == 0 || (filter.maskBits & bits.category) == 0)
+        {
+          // Ignore and continue
+          return -1.f;
+        }
+        hit = fixture;
+        hit_point = point;
+        // Clip the ray, only closer fixtures are reported after this
+        return fraction;
+      }
+
+      b2Fixture* hit = nullptr;
+      b2Vec2 hit_point;
+
+    private:
+      int16 group;
+      Collision::Bits bits;
+  };
+
+  /**
+    *   @class BlastQuery
+    *   @brief Collects solid fixtures within the blast radius
+    */
+  class BlastQuery : public b2QueryCallback
+  {
+    public:
+      BlastQuery(b2Vec2 blast_center, float blast_radius, std::vector<b2Fixture*>& found)
+        : center(blast_center), radius_squared(blast_radius * blast_radius), fixtures(found) {}
+
+      bool ReportFixture(b2Fixture* fixture) override
+      {
+        if (fixture->IsSensor())
+        {
+          return true;
+        }
+        // Distance to the closest point of the fixture's bounding box
+        const b2AABB& box = fixture->GetAABB(0);
+        b2Vec2 closest(std::min(std::max(center.x, box.lowerBound.x), box.upperBound.x),
+                       std::min(std::max(center.y, box.lowerBound.y), box.upperBound.y));
+        if (b2DistanceSquared(center, closest) <= radius_squared)
+        {
+          fixtures.push_back(fixture);
+        }
+        // Continue the query
+        return true;
+      }
+
+    private:
+      b2Vec2 center;
+      float radius_squared;
+      std::vector<b2Fixture*>& fixtures;
+  };
+}
+
+ProjectileSystem::ProjectileSystem(b2World* world) : world(world) {}
+
+void ProjectileSystem::spawn(Weapons::ID weapon_id, b2Vec2 position, b2Vec2 velocity, Entity* shooter, int16 shooter_group)
+{
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[weapon_id];
+  x.push_back(position.x);
+  y.push_back(position.y);
+  previous_x.push_back(position.x);
+  previous_y.push_back(position.y);
+  vx.push_back(velocity.x);
+  vy.push_back(velocity.y);
+  gravity_scale.push_back(spec.gravity_scale);
+  ticks_left.push_back(LIFETIME_TICKS);
+  damage.push_back(spec.damage);
+  group.push_back(shooter_group);
+  weapon.push_back(weapon_id);
+  owner.push_back(shooter);
+}
+
+void ProjectileSystem::step(float time_step, float level_width, std::vector<ProjectileHit>& hits)
+{
+  const std::size_t count = x.size();
+  const b2Vec2 gravity = world->GetGravity();
+  // Box2D bodies can't move more than b2_maxTranslation per step, bullet
+  // bodies flew at this cap, keep the same speed
+  const float max_speed = b2_maxTranslation / time_step;
+  const float half_step_squared = 0.5f * time_step * time_step;
+
+  previous_x.assign(x.begin(), x.end());
+  previous_y.assign(y.begin(), y.end());
+  for (std::size_t i = 0; i < count; i++)
+  {
+    float speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i]);
+    float ratio = std::min(1.f, max_speed / std::max(speed, 1e-6f));
+    vx[i] *= ratio;
+    vy[i] *= ratio;
+    float ax = gravity.x * gravity_scale[i];
+    float ay = gravity.y * gravity_scale[i];
+    x[i] += vx[i] * time_step + ax * half_step_squared;
+    y[i] += vy[i] * time_step + ay * half_step_squared;
+    vx[i] += ax * time_step;
+    vy[i] += ay * time_step;
+    ticks_left[i]--;
+  }
+
+  // Backwards, Remove moves an already checked projectile to i
+  const float right = level_width * Game::TOMETERS;
+  const float bottom = Game::HEIGHT * Game::TOMETERS;
+  for (std::size_t i = count; i-- > 0; )
+  {
+    b2Vec2 from(previous_x[i], previous_y[i]);
+    b2Vec2 to(x[i], y[i]);
+    if (b2DistanceSquared(from, to) > b2_linearSlop * b2_linearSlop)
+    {
+      ProjectileRayCast callback(group[i]);
+      world->RayCast(&callback, from, to);
+      if (callback.hit != nullptr)
+      {
+        hits.push_back({ callback.hit, owner[i], damage[i], weapon[i], callback.hit_point });
+        Remove(i);
+        continue;
+      }
+    }
+    if (x[i] < 0 || x[i] > right || y[i] < 0 || y[i] > bottom)
+    {
+      out_of_bounds++;
+      Remove(i);
+    }
+    else if (ticks_left[i] <= 0)
+    {
+      expired++;
+      Remove(i);
+    }
+  }
+}
+
+void ProjectileSystem::queryBlast(b2Vec2 center, float radius, std::vector<b2Fixture*>& fixtures) const
+{
+  b2AABB box;
+  box.lowerBound = center - b2Vec2(radius, radius);
+  box.upperBound = center + b2Vec2(radius, radius);
+  BlastQuery query(center, radius, fixtures);
+  world->QueryAABB(&query, box);
+}
+
+void ProjectileSystem::removeOwner(Entity* removed)
+{
+  for (std::size_t i = x.size(); i-- > 0; )
+  {
+    if (owner[i] == removed)
+    {
+      Remove(i);
+    }
+  }
+}
+
+void ProjectileSystem::clear()
+{
+  x.clear();
+  y.clear();
+  previous_x.clear();
+  previous_y.clear();
+  vx.clear();
+  vy.clear();
+  gravity_scale.clear();
+  ticks_left.clear();
+  damage.clear();
+  group.clear();
+  weapon.clear();
+  owner.clear();
+  expired = 0;
+  out_of_bounds = 0;
+}
+
+void ProjectileSystem::setWorld(b2World* new_world)
+{
+  world = new_world;
+}
+
+void ProjectileSystem::exportState(std::vector<ProjectileState>& states) const
+{
+  for (std::size_t i = 0; i < x.size(); i++)
+  {
+    const Weapons::ProjectileSpec& spec = Weapons::Projectiles[weapon[i]];
+    states.push_back(ProjectileState{sf::Vector2f(previous_x[i], previous_y[i]) * Game::TOPIXELS,
+                                     sf::Vector2f(x[i], y[i]) * Game::TOPIXELS,
+                                     sf::Vector2f(spec.width, spec.height)});
+  }
+}
+
+std::size_t ProjectileSystem::size() const
+{
+  return x.size();
+}
+
+long ProjectileSystem::getExpiredCount() const
+{
+  return expired;
+}
+
+long ProjectileSystem::getOutOfBoundsCount() const
+{
+  return out_of_bounds;
+}
+
+void ProjectileSystem::Remove(std::size_t i)
+{
+  const std::size_t last = x.size() - 1;
+  x[i] = x[last];
+  y[i] = y[last];
+  previous_x[i] = previous_x[last];
+  previous_y[i] = previous_y[last];
+  vx[i] = vx[last];
+  vy[i] = vy[last];
+  gravity_scale[i] = gravity_scale[last];
+  ticks_left[i] = ticks_left[last];
+  damage[i] = damage[last];
+  group[i] = group[last];
+  weapon[i] = weapon[last];
+  owner[i] = owner[last];
+  x.pop_back();
+  y.pop_back();
+  previous_x.pop_back();
+  previous_y.pop_back();
+  vx.pop_back();
+  vy.pop_back();
+  gravity_scale.pop_back();
+  ticks_left.pop_back();
+  damage.pop_back();
+  group.pop_back();
+  weapon.pop_back();
+  owner.pop_back();
+}
@@ -0,0 +1,149 @@
+/**
+  *   @file ProjectileSystem.hpp
+  *   @brief Header for ProjectileSystem class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include "RenderFrame.hpp"
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+class Entity;
+
+/**
+  *   @struct ProjectileHit
+  *   @brief Projectile that hit a fixture during the last step
+  */
+struct ProjectileHit
+{
+  b2Fixture* fixture; /**< Fixture that was hit */
+  Entity* owner; /**< Shooter of the projectile */
+  int damage; /**< Damage of the projectile */
+  Weapons::ID weapon; /**< Weapon that fired the projectile */
+  b2Vec2 point; /**< Impact point in meters */
+};
+
+/**
+  *   @class ProjectileSystem
+  *   @brief Ballistic projectiles simulated outside Box2D
+  *   @details Projectiles are points with gravity, stored as parallel arrays.
+  *   Trajectories are integrated analytically in one tight loop and hits are
+  *   found with one b2World::RayCast per projectile and tick along the moved
+  *   segment. Projectiles have no bodies, so they cost no broadphase proxies,
+  *   contacts or continuous collision.
+  *   @remark Projectiles don't hit each other
+  */
+class ProjectileSystem
+{
+  public:
+
+    static const int LIFETIME_TICKS; /**< Projectile is retired after this many steps */
+
+    /**
+      *   @brief Constructor
+      *   @param world Box2D world used for gravity and ray casts
+      */
+    explicit ProjectileSystem(b2World* world);
+
+    /**
+      *   @brief Fire a projectile
+      *   @param weapon Weapon whose ProjectileSpec is used
+      *   @param position Start position in meters
+      *   @param velocity Start velocity in meters per second
+      *   @param owner Shooter, credited for kills
+      *   @param group Collision group of the shooter, fixtures of the group aren't hit
+      */
+    void spawn(Weapons::ID weapon, b2Vec2 position, b2Vec2 velocity, Entity* owner, int16 group);
+
+    /**
+      *   @brief Move all projectiles one step and detect hits
+      *   @details Projectiles that hit something, leave the level or expire
+      *   are removed
+      *   @param time_step Step length in seconds
+      *   @param level_width Level width in pixels
+      *   @param hits Hits of this step are appended here
+      */
+    void step(float time_step, float level_width, std::vector<ProjectileHit>& hits);
+
+    /**
+      *   @brief Find fixtures hit by a blast
+      *   @details One b2World::QueryAABB over the bounding box of the blast,
+      *   then fixtures whose bounding box is farther than radius are dropped.
+      *   Sensors are skipped.
+      *   @param center Blast center in meters
+      *   @param radius Blast radius in meters
+      *   @param fixtures Fixtures in the blast are appended here
+      */
+    void queryBlast(b2Vec2 center, float radius, std::vector<b2Fixture*>& fixtures) const;
+
+    /**
+      *   @brief Remove projectiles of a removed entity
+      *   @param owner Removed entity
+      */
+    void removeOwner(Entity* owner);
+
+    /**
+      *   @brief Remove all projectiles and reset counters
+      */
+    void clear();
+
+    /**
+      *   @brief Use another Box2D world, call after clear
+      *   @param world Box2D world used for gravity and ray casts
+      */
+    void setWorld(b2World* world);
+
+    /**
+      *   @brief Copy projectile quads for the render thread
+      *   @param states Projectiles are appended, in pixels
+      */
+    void exportState(std::vector<ProjectileState>& states) const;
+
+    /**
+      *   @return Returns the amount of live projectiles
+      */
+    std::size_t size() const;
+
+    /**
+      *   @return Returns the amount of projectiles retired by lifetime
+      */
+    long getExpiredCount() const;
+
+    /**
+      *   @return Returns the amount of projectiles retired after leaving the level
+      */
+    long getOutOfBoundsCount() const;
+
+  private:
+
+    /**
+      *   @brief Remove projectile by moving the last one to its place
+      *   @param i Projectile index
+      */
+    void Remove(std::size_t i);
+
+    b2World* world;
+
+    /*  Projectile state, one element per projectile  */
+    std::vector<float> x; /**< Position in meters */
+    std::vector<float> y;
+    std::vector<float> vx; /**< Velocity in meters per second */
+    std::vector<float> vy;
+    std::vector<float> gravity_scale;
+    std::vector<int> ticks_left;
+    std::vector<int> damage;
+    std::vector<int16> group;
+    std::vector<Weapons::ID> weapon;
+    std::vector<Entity*> owner;
+
+    std::vector<float> previous_x; /**< Positions before the last integration, moved along with the state */
+    std::vector<float> previous_y;
+    long expired = 0;
+    long out_of_bounds = 0;
+};
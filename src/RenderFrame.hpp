@@ -0,0 +1,129 @@
+/**
+  *   @file RenderFrame.hpp
+  *   @brief Drawable state of one simulation step, consumed by RenderThread
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+  *   @struct SpriteState
+  *   @brief Copy of an entity sprite after a step
+  */
+struct SpriteState
+{
+  Textures::ID texture;
+  sf::IntRect texture_rect; /**< Tells the facing */
+  sf::Vector2f origin;
+  sf::Vector2f scale;
+  sf::Vector2f previous_position; /**< Position before the step */
+  sf::Vector2f position;
+  float previous_rotation; /**< Rotation before the step */
+  float rotation;
+
+  /**
+    *   @return Returns the bounding rectangle of the current transform
+    */
+  sf::FloatRect getBounds() const
+  {
+    sf::Transformable transform;
+    transform.setOrigin(origin);
+    transform.setScale(scale);
+    transform.setPosition(position);
+    transform.setRotation(rotation);
+    return transform.getTransform().transformRect(sf::FloatRect(0.f, 0.f, std::abs(texture_rect.width), std::abs(texture_rect.height)));
+  }
+};
+
+/**
+  *   @struct ParticleState
+  *   @brief Particle quad after a step, in pixels
+  */
+struct ParticleState
+{
+  sf::Vector2f previous_position; /**< Center before the step */
+  sf::Vector2f position;
+  float size; /**< Quad side */
+  sf::Color color; /**< Alpha fades over the lifetime */
+};
+
+/**
+  *   @struct Scenery
+  *   @brief Entities that never move, drawn to a cached background layer
+  *   @details Not changed after it is published. A new Scenery is made when
+  *   static entities are destroyed, dirty tells the regions that changed
+  *   since the previous version so that only those are drawn again.
+  */
+struct Scenery
+{
+  long level; /**< Changes whenever the world is cleared, the whole layer is drawn again */
+  long version; /**< Increased by one per change of the level */
+  sf::Vector2f size; /**< Layer size in pixels */
+  std::vector<SpriteState> sprites;
+  std::vector<sf::FloatRect> dirty; /**< Regions changed since version - 1 */
+};
+
+/**
+  *   @struct MinimapImage
+  *   @brief Units of the whole level by team, one pixel per Minimap cell
+  *   @details Not changed after it is published, the render thread uploads
+  *   it to a texture when a frame brings a new image
+  */
+struct MinimapImage
+{
+  sf::Vector2u size; /**< Image size in pixels (cells) */
+  sf::Vector2f level_size; /**< Level size in pixels, maps the camera to the image */
+  std::vector<sf::Uint8> pixels; /**< RGBA, row by row */
+};
+
+/**
+  *   @struct ProjectileState
+  *   @brief Projectile quad after a step, in pixels
+  */
+struct ProjectileState
+{
+  sf::Vector2f previous_position; /**< Center before the step */
+  sf::Vector2f position;
+  sf::Vector2f size;
+};
+
+/**
+  *   @struct RenderFrame
+  *   @brief Everything drawn of one step
+  *   @details Filled by the simulation thread and not changed after
+  *   RenderThread::publish, the render thread draws it between the previous
+  *   and the current transforms
+  */
+struct RenderFrame
+{
+  std::shared_ptr<const Scenery> scenery; /**< Drawn before the sprites, shared by frames until it changes */
+  std::vector<SpriteState> sprites; /**< Drawn in order */
+  std::vector<ProjectileState> projectiles; /**< Drawn in one draw call after the sprites */
+  std::vector<ParticleState> particles; /**< Drawn in one draw call after the projectiles */
+  std::shared_ptr<const MinimapImage> minimap; /**< Drawn over the corner, nullptr hides the minimap */
+  sf::Vector2f previous_camera; /**< Camera center before the step */
+  sf::Vector2f camera;
+  std::string info; /**< Game info text */
+  std::chrono::steady_clock::time_point published; /**< Set by RenderThread::publish */
+
+  /**
+    *   @brief Empty the frame, capacity is kept
+    */
+  void clear()
+  {
+    sprites.clear();
+    projectiles.clear();
+    particles.clear();
+    minimap.reset();
+    info.clear();
+  }
+};
@@ -0,0 +1,472 @@
+/**
+  *   @file RenderThread.cpp
+  *   @brief Source code for class RenderThread
+  */
+
+#include "RenderThread.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  sf::Vector2f Lerp(sf::Vector2f from, sf::Vector2f to, float alpha)
+  {
+    return from + (to - from) * alpha;
+  }
+
+  float LerpAngle(float from, float to, float alpha)
+  {
+    // Shortest way around, rotations are 0...360
+    float turn = std::fmod(to - from + 540.f, 360.f) - 180.f;
+    return from + turn * alpha;
+  }
+}
+
+RenderThread::RenderThread(sf::RenderWindow& window, const ResourceManager& resources, const sf::Font& font,
+                           std::chrono::steady_clock::duration step)
+  : window(window), resources(resources), step(step), vertices(sf::Quads), particle_vertices(sf::Quads), scaler(step)
+{
+  view.reset(sf::FloatRect(0.f, 0.f, Game::WIDTH, Game::HEIGHT));
+  info.setFont(font);
+  info.setPosition(10.f, 10.f);
+  info.setCharacterSize(10);
+  minimap_camera.setFillColor(sf::Color::Transparent);
+  minimap_camera.setOutlineColor(sf::Color::White);
+  minimap_camera.setOutlineThickness(1.f);
+}
+
+RenderThread::~RenderThread()
+{
+  stop();
+}
+
+void RenderThread::start()
+{
+  if (running())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = false;
+    fresh = false;
+  }
+  // A context can be active on one thread only
+  window.setActive(false);
+  thread = std::thread(&RenderThread::Loop, this);
+}
+
+void RenderThread::stop()
+{
+  if (! running())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  published.notify_one();
+  thread.join();
+  window.setActive(true);
+}
+
+bool RenderThread::running() const
+{
+  return thread.joinable();
+}
+
+RenderFrame& RenderThread::back()
+{
+  return frames[back_frame];
+}
+
+void RenderThread::publish()
+{
+  frames[back_frame].published = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(back_frame, ready_frame);
+    fresh = true;
+  }
+  published.notify_one();
+}
+
+void RenderThread::setRecorder(FrameRecorder* frame_recorder, bool show)
+{
+  recorder = frame_recorder;
+  show_window = show;
+}
+
+void RenderThread::setResolutionScale(float scale, bool automatic)
+{
+  scaler.setScale(scale, automatic);
+  resolution_scale = scaler.getScale();
+}
+
+float RenderThread::getResolutionScale() const
+{
+  return resolution_scale;
+}
+
+void RenderThread::setVerticalSync(bool enabled)
+{
+  vsync = enabled;
+}
+
+long RenderThread::getFrames() const
+{
+  return drawn;
+}
+
+float RenderThread::getAverageDrawMs() const
+{
+  long count = drawn;
+  return count > 0 ? draw_micros / 1000.f / count : 0.f;
+}
+
+int RenderThread::getDrawnCount() const
+{
+  return drawn_count;
+}
+
+int RenderThread::getCulledCount() const
+{
+  return culled_count;
+}
+
+long RenderThread::getSceneryRenders() const
+{
+  return scenery_renders;
+}
+
+long RenderThread::getSceneryRegionRenders() const
+{
+  return scenery_region_renders;
+}
+
+void RenderThread::Loop()
+{
+  window.setActive(true);
+  bool vsync_applied = ! vsync;
+  bool has_frame = false;
+  while (true)
+  {
+    // Recording captures every published frame once
+    bool wait = ! vsync || recorder != nullptr;
+    bool new_frame = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (! has_frame)
+      {
+        // Nothing to draw yet, vsync can't pace the loop
+        published.wait(lock, [this] { return fresh || stopping; });
+      }
+      else if (wait)
+      {
+        // Without vsync draw each published frame once
+        published.wait_for(lock, step, [this] { return fresh || stopping; });
+      }
+      if (stopping)
+      {
+        break;
+      }
+      if (fresh)
+      {
+        std::swap(front_frame, ready_frame);
+        fresh = false;
+        has_frame = true;
+        new_frame = true;
+      }
+    }
+    if (vsync_applied != vsync)
+    {
+      vsync_applied = vsync;
+      window.setVerticalSyncEnabled(vsync_applied);
+    }
+    if (! has_frame || (recorder != nullptr && ! new_frame))
+    {
+      continue;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const RenderFrame& frame = frames[front_frame];
+    if (recorder != nullptr)
+    {
+      Capture(frame);
+    }
+    else
+    {
+      float alpha = std::chrono::duration<float>(start - frame.published) / std::chrono::duration<float>(step);
+      Draw(window, frame, std::min(std::max(alpha, 0.f), 1.f));
+      window.display();
+      if (! vsync_applied)
+      {
+        // Display doesn't wait, so this is what drawing the frame costs
+        scaler.addFrame(std::chrono::steady_clock::now() - start);
+        resolution_scale = scaler.getScale();
+      }
+    }
+    draw_micros += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    drawn++;
+  }
+  // Next start may be another level on the same layer
+  scenery.reset();
+  minimap.reset();
+  window.setActive(false);
+}
+
+void RenderThread::Draw(sf::RenderTarget& target, const RenderFrame& frame, float alpha)
+{
+  float scale = scaler.getScale();
+  sf::Vector2u size = target.getSize();
+  if (scale < ResolutionScaler::MAX_SCALE && ! scaled_failed && scaled_world.getSize() != size)
+  {
+    // Created once at full size, scale changes only move the viewport
+    scaled_failed = ! scaled_world.create(size.x, size.y);
+    scaled_world.setSmooth(true);
+  }
+  if (scale < ResolutionScaler::MAX_SCALE && ! scaled_failed)
+  {
+    // Only the top left part of the texture is rasterized
+    view.setViewport(sf::FloatRect(0.f, 0.f, scale, scale));
+    DrawWorld(scaled_world, frame, alpha);
+    scaled_world.display();
+    sf::IntRect drawn = scaled_world.getViewport(view);
+    view.setViewport(sf::FloatRect(0.f, 0.f, 1.f, 1.f));
+
+    // Stretched over the target with bilinear filtering
+    sf::Sprite upscaled(scaled_world.getTexture(), drawn);
+    upscaled.setScale(static_cast<float>(size.x) / drawn.width, static_cast<float>(size.y) / drawn.height);
+    target.setView(target.getDefaultView());
+    target.draw(upscaled);
+  }
+  else
+  {
+    DrawWorld(target, frame, alpha);
+  }
+
+  target.setView(target.getDefaultView());
+  if (frame.minimap)
+  {
+    DrawMinimap(target, frame.minimap, sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize()));
+  }
+  info.setString(frame.info);
+  target.draw(info);
+}
+
+void RenderThread::DrawWorld(sf::RenderTarget& target, const RenderFrame& frame, float alpha)
+{
+  target.clear(sf::Color(150,200,255));
+  view.setCenter(Lerp(frame.previous_camera, frame.camera, alpha));
+  target.setView(view);
+  const sf::FloatRect visible(view.getCenter() - view.getSize() / 2.f, view.getSize());
+  int drawn_sprites = 0;
+  int culled = 0;
+
+  if (frame.scenery)
+  {
+    UpdateScenery(frame.scenery);
+    if (scenery_cached)
+    {
+      // Static entities in one textured quad
+      target.draw(sf::Sprite(scenery_layer.getTexture()));
+    }
+    else
+    {
+      for (const SpriteState& state : frame.scenery->sprites)
+      {
+        if (DrawSprite(target, state, 1.f, visible))
+        {
+          drawn_sprites++;
+        }
+        else
+        {
+          culled++;
+        }
+      }
+    }
+  }
+
+  for (const SpriteState& state : frame.sprites)
+  {
+    if (DrawSprite(target, state, alpha, visible))
+    {
+      drawn_sprites++;
+    }
+    else
+    {
+      culled++;
+    }
+  }
+
+  // All projectiles in one draw call
+  const sf::Texture& bullet = resources.get(Textures::Bullet_alpha);
+  const sf::Vector2f texture_size(bullet.getSize());
+  vertices.resize(frame.projectiles.size() * 4);
+  std::size_t quads = 0;
+  for (const ProjectileState& state : frame.projectiles)
+  {
+    sf::Vector2f center = Lerp(state.previous_position, state.position, alpha);
+    sf::Vector2f half = state.size / 2.f;
+    if (! visible.intersects(sf::FloatRect(center - half, state.size)))
+    {
+      culled++;
+      continue;
+    }
+    sf::Vertex* quad = &vertices[quads++ * 4];
+    quad[0].position = center + sf::Vector2f(-half.x, -half.y);
+    quad[1].position = center + sf::Vector2f(half.x, -half.y);
+    quad[2].position = center + sf::Vector2f(half.x, half.y);
+    quad[3].position = center + sf::Vector2f(-half.x, half.y);
+    quad[0].texCoords = sf::Vector2f(0, 0);
+    quad[1].texCoords = sf::Vector2f(texture_size.x, 0);
+    quad[2].texCoords = texture_size;
+    quad[3].texCoords = sf::Vector2f(0, texture_size.y);
+  }
+  if (quads > 0)
+  {
+    target.draw(&vertices[0], quads * 4, sf::Quads, &bullet);
+  }
+
+  // All particles in one draw call
+  particle_vertices.resize(frame.particles.size() * 4);
+  std::size_t particle_quads = 0;
+  for (const ParticleState& state : frame.particles)
+  {
+    sf::Vector2f center = Lerp(state.previous_position, state.position, alpha);
+    float half = state.size / 2.f;
+    if (! visible.contains(center))
+    {
+      culled++;
+      continue;
+    }
+    sf::Vertex* quad = &particle_vertices[particle_quads++ * 4];
+    quad[0].position = center + sf::Vector2f(-half, -half);
+    quad[1].position = center + sf::Vector2f(half, -half);
+    quad[2].position = center + sf::Vector2f(half, half);
+    quad[3].position = center + sf::Vector2f(-half, half);
+    quad[0].color = quad[1].color = quad[2].color = quad[3].color = state.color;
+  }
+  if (particle_quads > 0)
+  {
+    target.draw(&particle_vertices[0], particle_quads * 4, sf::Quads);
+  }
+  drawn_count = drawn_sprites + static_cast<int>(quads + particle_quads);
+  culled_count = culled;
+}
+
+void RenderThread::DrawMinimap(sf::RenderTarget& target, const std::shared_ptr<const MinimapImage>& image,
+                               const sf::FloatRect& visible)
+{
+  if (image != minimap)
+  {
+    // A few kilobytes, new images come every few steps at most
+    if (minimap_texture.getSize() != image->size && ! minimap_texture.create(image->size.x, image->size.y))
+    {
+      return;
+    }
+    minimap_texture.update(image->pixels.data());
+    minimap = image;
+  }
+  const float margin = 10.f;
+  sf::Vector2f corner(target.getView().getSize().x - image->size.x - margin, margin);
+  sf::Sprite map(minimap_texture);
+  map.setPosition(corner);
+  target.draw(map);
+
+  sf::Vector2f scale(image->size.x / image->level_size.x, image->size.y / image->level_size.y);
+  minimap_camera.setPosition(corner.x + visible.left * scale.x, corner.y + visible.top * scale.y);
+  minimap_camera.setSize(sf::Vector2f(visible.width * scale.x, visible.height * scale.y));
+  target.draw(minimap_camera);
+}
+
+void RenderThread::Capture(const RenderFrame& frame)
+{
+  sf::Vector2u size = recorder->getSize();
+  if (capture.getSize() != size && ! capture.create(size.x, size.y))
+  {
+    return;
+  }
+  // Steps are captured as they are, not between two steps
+  Draw(capture, frame, 1.f);
+  capture.display();
+  // SFML reads textures back synchronously, encoding runs on the recorder threads
+  sf::Image image = capture.getTexture().copyToImage();
+  recorder->submit(image.getPixelsPtr());
+  if (show_window)
+  {
+    window.clear();
+    window.draw(sf::Sprite(capture.getTexture()));
+    window.display();
+  }
+}
+
+void RenderThread::UpdateScenery(const std::shared_ptr<const Scenery>& next)
+{
+  if (next == scenery)
+  {
+    return;
+  }
+  bool next_version = scenery && scenery->level == next->level && scenery->version + 1 == next->version;
+  if (next_version && scenery_cached)
+  {
+    for (const sf::FloatRect& region : next->dirty)
+    {
+      DrawSceneryRegion(*next, region);
+      scenery_region_renders++;
+    }
+  }
+  else
+  {
+    sf::Vector2u size(static_cast<unsigned>(std::ceil(next->size.x)), static_cast<unsigned>(std::ceil(next->size.y)));
+    scenery_cached = scenery_layer.getSize() == size || scenery_layer.create(size.x, size.y);
+    if (scenery_cached)
+    {
+      DrawSceneryRegion(*next, sf::FloatRect(0.f, 0.f, next->size.x, next->size.y));
+      scenery_renders++;
+    }
+  }
+  if (scenery_cached)
+  {
+    scenery_layer.display();
+  }
+  scenery = next;
+}
+
+void RenderThread::DrawSceneryRegion(const Scenery& layer, const sf::FloatRect& region)
+{
+  // Clip to the region, the viewport covers the same pixels the view shows
+  sf::View clip(region);
+  sf::Vector2f size = layer.size;
+  clip.setViewport(sf::FloatRect(region.left / size.x, region.top / size.y, region.width / size.x, region.height / size.y));
+  scenery_layer.setView(clip);
+
+  // Replace the region with transparent pixels, blending would keep the old ones
+  sf::RectangleShape erase(sf::Vector2f(region.width, region.height));
+  erase.setPosition(region.left, region.top);
+  erase.setFillColor(sf::Color::Transparent);
+  scenery_layer.draw(erase, sf::RenderStates(sf::BlendNone));
+
+  for (const SpriteState& state : layer.sprites)
+  {
+    DrawSprite(scenery_layer, state, 1.f, region);
+  }
+  scenery_layer.setView(scenery_layer.getDefaultView());
+}
+
+bool RenderThread::DrawSprite(sf::RenderTarget& target, const SpriteState& state, float alpha, const sf::FloatRect& visible)
+{
+  sprite.setTexture(resources.get(state.texture));
+  sprite.setTextureRect(state.texture_rect);
+  sprite.setOrigin(state.origin);
+  sprite.setScale(state.scale);
+  sprite.setPosition(Lerp(state.previous_position, state.position, alpha));
+  sprite.setRotation(LerpAngle(state.previous_rotation, state.rotation, alpha));
+  if (! sprite.getGlobalBounds().intersects(visible))
+  {
+    return false;
+  }
+  target.draw(sprite);
+  return true;
+}
@@ -0,0 +1,250 @@
+/**
+  *   @file RenderThread.hpp
+  *   @brief Header for RenderThread class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "RenderFrame.hpp"
+#include "ResourceManager.hpp"
+#include "FrameRecorder.hpp"
+#include "ResolutionScaler.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+  *   @class RenderThread
+  *   @brief Draws published RenderFrames on its own thread
+  *   @details The simulation fills back() and publishes it at the end of a
+  *   step, the render thread draws the newest published frame. Frames are
+  *   double-buffered between the threads, a third slot holds the newest
+  *   published frame so that neither side waits for the other: drawing step N
+  *   overlaps simulating step N+1 and a long draw doesn't stall physics.
+  *   The window's OpenGL context belongs to the render thread while it runs.
+  *   @remark Call start, stop and publish from the thread that owns the window
+  */
+class RenderThread
+{
+  public:
+
+    /**
+      *   @brief Constructor, the thread isn't started
+      *   @param window Window drawn to
+      *   @param resources Textures of the frames, only read
+      *   @param font Font of the info text
+      *   @param step Simulation step, frames are interpolated over one step
+      */
+    RenderThread(sf::RenderWindow& window, const ResourceManager& resources, const sf::Font& font,
+                 std::chrono::steady_clock::duration step);
+
+    /**
+      *   @brief Destructor, stops the thread
+      */
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+      *   @brief Start drawing, the window context moves to the render thread
+      */
+    void start();
+
+    /**
+      *   @brief Stop drawing, the window context moves back to the caller
+      */
+    void stop();
+
+    /**
+      *   @return Returns true between start and stop
+      */
+    bool running() const;
+
+    /**
+      *   @return Returns the frame to be filled by the simulation
+      */
+    RenderFrame& back();
+
+    /**
+      *   @brief Hand the back frame to the render thread
+      *   @details Replaces a published frame that wasn't drawn yet
+      */
+    void publish();
+
+    /**
+      *   @brief Set vertical sync, applied by the render thread
+      *   @details Without vsync every published frame is drawn once. With
+      *   vsync the thread draws every displayed frame and interpolates.
+      */
+    void setVerticalSync(bool enabled);
+
+    /**
+      *   @brief Record every published frame
+      *   @details Frames are drawn to an offscreen texture of the recorder
+      *   size and submitted to the recorder, the window only shows the
+      *   texture. Call when the thread isn't running.
+      *   @param frame_recorder Recorder, nullptr stops recording
+      *   @param show Show the captured frames in the window, false when
+      *   recording headless
+      */
+    void setRecorder(FrameRecorder* frame_recorder, bool show);
+
+    /**
+      *   @brief Set the resolution the world is drawn at
+      *   @details Below native resolution the world is drawn to an offscreen
+      *   texture and stretched over the window, the info text and the
+      *   minimap stay sharp. In automatic mode the scale follows the drawing
+      *   time of the frames, with vsync the display wait hides the drawing
+      *   time and the scale is kept. Recorded frames don't change the scale.
+      *   Call when the thread isn't running.
+      *   @param scale Share of the window resolution, see ResolutionScaler
+      *   @param automatic Lower the scale when frames take too long, scale
+      *   is the highest scale used
+      */
+    void setResolutionScale(float scale, bool automatic);
+
+    /**
+      *   @return Returns the scale of the last frame
+      */
+    float getResolutionScale() const;
+
+    /**
+      *   @return Returns the amount of frames drawn
+      */
+    long getFrames() const;
+
+    /**
+      *   @return Returns the average time of drawing a frame in milliseconds
+      */
+    float getAverageDrawMs() const;
+
+    /**
+      *   @return Returns sprites and projectiles drawn in the last frame
+      */
+    int getDrawnCount() const;
+
+    /**
+      *   @return Returns sprites and projectiles of the last frame culled outside the view
+      */
+    int getCulledCount() const;
+
+    /**
+      *   @return Returns how many times the whole scenery layer was drawn
+      */
+    long getSceneryRenders() const;
+
+    /**
+      *   @return Returns how many dirty regions of the scenery layer were drawn
+      */
+    long getSceneryRegionRenders() const;
+
+  private:
+
+    /**
+      *   @brief Thread function
+      */
+    void Loop();
+
+    /**
+      *   @brief Draw a frame
+      *   @param target Window or capture texture
+      *   @param frame Frame to be drawn
+      *   @param alpha Fraction of a step since the frame was published, 0...1
+      */
+    void Draw(sf::RenderTarget& target, const RenderFrame& frame, float alpha);
+
+    /**
+      *   @brief Draw the level part of a frame in the scrolling view
+      *   @param target Target whose viewport the view covers
+      *   @param frame Frame to be drawn
+      *   @param alpha Fraction of a step since the frame was published, 0...1
+      */
+    void DrawWorld(sf::RenderTarget& target, const RenderFrame& frame, float alpha);
+
+    /**
+      *   @brief Draw a frame offscreen and submit it to the recorder
+      *   @param frame Frame to be captured
+      */
+    void Capture(const RenderFrame& frame);
+
+    /**
+      *   @brief Bring the scenery layer up to date
+      *   @details The next version only draws its dirty regions again, any
+      *   other scenery (new level, skipped version) draws the whole layer
+      *   @param scenery Scenery of the drawn frame
+      */
+    void UpdateScenery(const std::shared_ptr<const Scenery>& scenery);
+
+    /**
+      *   @brief Draw the scenery sprites that overlap a region to the layer
+      *   @param layer Scenery to be drawn
+      *   @param region Region in pixels, nothing outside it is touched
+      */
+    void DrawSceneryRegion(const Scenery& layer, const sf::FloatRect& region);
+
+    /**
+      *   @brief Draw the minimap to the top right corner
+      *   @details The texture is updated only when the frame brings a new image
+      *   @param target Window or capture texture, default view is set
+      *   @param image Minimap of the frame
+      *   @param visible Area of the level the camera shows, outlined on the minimap
+      */
+    void DrawMinimap(sf::RenderTarget& target, const std::shared_ptr<const MinimapImage>& image, const sf::FloatRect& visible);
+
+    /**
+      *   @brief Draw a sprite state if it overlaps the visible area
+      *   @param target Window or layer
+      *   @param state Sprite to be drawn
+      *   @param alpha Fraction of a step, 0...1
+      *   @param visible Visible area of the target
+      *   @return Returns false if the sprite was culled
+      */
+    bool DrawSprite(sf::RenderTarget& target, const SpriteState& state, float alpha, const sf::FloatRect& visible);
+
+    sf::RenderWindow& window;
+    const ResourceManager& resources;
+    std::chrono::steady_clock::duration step;
+    sf::View view; /**< Scrolling world view */
+    sf::Sprite sprite; /**< Reused for every sprite state */
+    sf::VertexArray vertices; /**< Projectile quads */
+    sf::VertexArray particle_vertices; /**< Particle quads, untextured */
+    sf::Text info;
+    sf::RenderTexture scenery_layer; /**< Static entities drawn once per change */
+    std::shared_ptr<const Scenery> scenery; /**< Scenery drawn to the layer */
+    sf::Texture minimap_texture; /**< One texel per minimap cell */
+    std::shared_ptr<const MinimapImage> minimap; /**< Image uploaded to minimap_texture */
+    sf::RectangleShape minimap_camera; /**< Outline of the visible area */
+    bool scenery_cached = false; /**< False if the layer couldn't be created, scenery is drawn sprite by sprite */
+    FrameRecorder* recorder = nullptr; /**< Records the frames if set */
+    bool show_window = true; /**< Captured frames are shown in the window */
+    sf::RenderTexture capture; /**< Offscreen target of the recorded frames */
+    ResolutionScaler scaler; /**< Scale of the world, used only by the render thread */
+    sf::RenderTexture scaled_world; /**< Target size, the world is drawn to its top left part below native resolution */
+    bool scaled_failed = false; /**< Offscreen target couldn't be created, drawn at native resolution */
+
+    std::array<RenderFrame, 3> frames;
+    std::size_t back_frame = 0; /**< Filled by the simulation */
+    std::size_t ready_frame = 1; /**< Newest published frame */
+    std::size_t front_frame = 2; /**< Drawn by the render thread */
+    bool fresh = false; /**< ready_frame wasn't taken yet */
+    bool stopping = false;
+    std::mutex mutex; /**< Guards ready_frame, fresh and stopping */
+    std::condition_variable published;
+    std::thread thread;
+
+    std::atomic<bool> vsync{false};
+    std::atomic<long> drawn{0};
+    std::atomic<long> draw_micros{0};
+    std::atomic<int> drawn_count{0};
+    std::atomic<int> culled_count{0};
+    std::atomic<long> scenery_renders{0};
+    std::atomic<long> scenery_region_renders{0};
+    std::atomic<float> resolution_scale{1.f};
+};
@@ -0,0 +1,75 @@
+/**
+  *   @file ResolutionScaler.cpp
+  *   @brief Source code for class ResolutionScaler
+  */
+
+#include "ResolutionScaler.hpp"
+#include <algorithm>
+
+/*  Member Initializations */
+const float ResolutionScaler::MIN_SCALE = 0.5f;
+const float ResolutionScaler::MAX_SCALE = 1.f;
+const int ResolutionScaler::SAMPLE_FRAMES = 30;
+const float ResolutionScaler::HIGH_LOAD = 0.9f;
+const float ResolutionScaler::LOW_LOAD = 0.6f;
+const float ResolutionScaler::DOWN_STEP = 0.1f;
+const float ResolutionScaler::UP_STEP = 0.05f;
+
+ResolutionScaler::ResolutionScaler(Clock::duration budget) : budget(budget)
+{
+}
+
+void ResolutionScaler::setScale(float new_scale, bool automatic_scale)
+{
+  scale = std::max(MIN_SCALE, std::min(new_scale, MAX_SCALE));
+  limit = scale;
+  automatic = automatic_scale;
+  total = Clock::duration::zero();
+  samples = 0;
+}
+
+void ResolutionScaler::addFrame(Clock::duration cost)
+{
+  if (! automatic)
+  {
+    return;
+  }
+  total += cost;
+  if (++samples < SAMPLE_FRAMES)
+  {
+    return;
+  }
+  float load = std::chrono::duration<float>(total / samples) / std::chrono::duration<float>(budget);
+  total = Clock::duration::zero();
+  samples = 0;
+
+  float next = scale;
+  if (load > HIGH_LOAD)
+  {
+    next = std::max(MIN_SCALE, scale - DOWN_STEP);
+  }
+  else if (load < LOW_LOAD)
+  {
+    next = std::min(limit, scale + UP_STEP);
+  }
+  if (next != scale)
+  {
+    scale = next;
+    changes++;
+  }
+}
+
+float ResolutionScaler::getScale() const
+{
+  return scale;
+}
+
+bool ResolutionScaler::isAutomatic() const
+{
+  return automatic;
+}
+
+long ResolutionScaler::getChanges() const
+{
+  return changes;
+}
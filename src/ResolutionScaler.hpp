@@ -0,0 +1,81 @@
+/**
+  *   @file ResolutionScaler.hpp
+  *   @brief Header for ResolutionScaler class
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include <chrono>
+
+/**
+  *   @class ResolutionScaler
+  *   @brief Share of the window resolution the world is drawn at
+  *   @details The scale is either fixed or follows the drawing time. In
+  *   automatic mode the times of SAMPLE_FRAMES frames are averaged: above
+  *   HIGH_LOAD of the budget the scale drops by DOWN_STEP, below LOW_LOAD it
+  *   grows by UP_STEP. Pixels drawn go with the square of the scale, so a
+  *   raise never takes a frame from below LOW_LOAD over HIGH_LOAD and the
+  *   scale doesn't swing back and forth.
+  */
+class ResolutionScaler
+{
+  public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static const float MIN_SCALE; /**< Lowest scale, also in automatic mode */
+    static const float MAX_SCALE; /**< Native resolution */
+    static const int SAMPLE_FRAMES; /**< Frames averaged per decision */
+    static const float HIGH_LOAD; /**< Share of the budget that lowers the scale */
+    static const float LOW_LOAD; /**< Share of the budget that raises the scale */
+    static const float DOWN_STEP;
+    static const float UP_STEP;
+
+    /**
+      *   @brief Constructor, automatic up to native resolution
+      *   @param budget Time one frame may take
+      */
+    explicit ResolutionScaler(Clock::duration budget);
+
+    /**
+      *   @brief Set the scale
+      *   @param scale Scale, clamped to MIN_SCALE...MAX_SCALE
+      *   @param automatic Follow the drawing time, scale is then the highest
+      *   scale used and the starting point
+      */
+    void setScale(float scale, bool automatic);
+
+    /**
+      *   @brief Add the drawing time of a frame
+      *   @details Ignored if the scale is fixed
+      *   @param cost Time from the start of drawing until the frame was displayed
+      */
+    void addFrame(Clock::duration cost);
+
+    /**
+      *   @return Returns the current scale
+      */
+    float getScale() const;
+
+    /**
+      *   @return Returns true if the scale follows the drawing time
+      */
+    bool isAutomatic() const;
+
+    /**
+      *   @return Returns how many times the automatic mode changed the scale
+      */
+    long getChanges() const;
+
+  private:
+
+    Clock::duration budget;
+    float scale = MAX_SCALE;
+    float limit = MAX_SCALE; /**< Highest scale of automatic mode */
+    bool automatic = true;
+    Clock::duration total{}; /**< Drawing time of the current sample */
+    int samples = 0; /**< Frames in the current sample */
+    long changes = 0;
+};
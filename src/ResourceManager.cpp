@@ -1,53 +1,42 @@
 #include "ResourceManager.hpp"
-#include <iostream>
 
-ResourceManager::ResourceManager()
+ResourceManager::ResourceManager(const std::vector<Textures::ID>& preload)
 {
-  try
+  std::vector<TextureHandle> handles = AssetCache::instance().acquire(preload);
+  for (std::size_t i = 0; i < preload.size(); i++)
   {
-    for (int enum_value = 0; enum_value != Textures::ID::id_end; enum_value++)
-    {
-      load(static_cast<Textures::ID>(enum_value), Paths::Paths[Paths::PATHS::img] +Textures::TextureFiles[enum_value]);
-    }
-  }
-  catch (std::runtime_error& e)
-  {
-    std::cout << "Exception: " << e.what() << std::endl;
+    textures[preload[i]] = std::move(handles[i]);
   }
 }
 
-void ResourceManager::load(Textures::ID id, const std::string& filename)
+std::vector<Textures::ID> ResourceManager::unitTextures()
 {
-  std::unique_ptr<sf::Texture> resource(new sf::Texture());
-  if (!resource->loadFromFile(filename))
-    throw std::runtime_error("ResrouceManager::load - Failed to load " + filename);
-  insertResource(id, resource);
+  // Editor images and the textures without alpha aren't used by the game
+  std::vector<Textures::ID> ids;
+  for (const auto& texture : Textures::alphaTextures)
+  {
+    ids.push_back(texture.second);
+  }
+  return ids;
 }
 
 const sf::Texture& ResourceManager::get(Textures::ID id) const
 {
-  auto found = resourceMap.find(id);
-  assert(found != resourceMap.end());
+  assert(textures[id] != nullptr);
 
-  return *found->second;
+  return *textures[id];
 }
 
+/**
+ * Textures not acquired yet are loaded here, one file at a time.
+ */
 sf::Texture & ResourceManager::get(Textures::ID id)
 {
-  auto found = resourceMap.find(id);
-  assert(found != resourceMap.end());
+  if (textures[id] == nullptr)
+  {
+    textures[id] = AssetCache::instance().acquire(id);
+  }
 
-  return *found->second;
+  return *textures[id];
   
 }
-
-/**
- * New textures will be actually inserted here. std::move is used to move the ownership of resource to std::make_pair.
- */
-void ResourceManager::insertResource(Textures::ID id, std::unique_ptr<sf::Texture> &resource)
-{
-  // Insert and check success
-  auto inserted = resourceMap.insert(std::make_pair(id, std::move(resource)));
-  assert(inserted.second);
-  (void)inserted;
-}
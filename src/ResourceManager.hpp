@@ -1,52 +1,50 @@
 /**
  * @file ResourceManager.hpp
- * @brief Resource manager which load and distribute resources (textures). The owner of resources is only this class, that's why unique pointer is used. Once this instance is out of scope, resources will be destroyed automatically by smart pointer. RAII.
+ * @brief Resource manager which distributes resources (textures). Textures are shared through AssetCache, this class holds a reference counted handle of every texture it has given out. Once the last holder is out of scope, the texture is destroyed. RAII.
  */
 #pragma once
-#include <map>
+#include <array>
 #include <string>
 #include <memory>
-#include <stdexcept>
+#include <vector>
 #include <cassert>
 #include <SFML/Graphics.hpp>
 #include "CommonDefinitions.hpp"
+#include "AssetCache.hpp"
 
 /**
   *   @class ResourceManager
   *   @brief Class used to handle shared resources
-  *   @details Textures are loaded through this class
+  *   @details Textures are acquired from the process wide AssetCache, so
+  *   every ResourceManager shares the same textures and a file is decoded
+  *   once however many managers use it
   */
 
 class ResourceManager{
 public:
-  ResourceManager();
   /**
-   * @brief get a texture based on texture ID.
+   * @brief Acquire the preloaded textures, the files are decoded in parallel
+   * @param preload Textures needed right away, others are loaded by the first non-const get
+   */
+  explicit ResourceManager(const std::vector<Textures::ID>& preload = unitTextures());
+  /**
+   * @brief get a texture based on texture ID, load it if needed.
    * @param id resource enum id.
-   * @return a texture reference from the resource map.
+   * @return a texture reference, empty texture if the file couldn't be read.
    */
   sf::Texture & get(Textures::ID id);
   /**
    * @brief get a texture based on texture ID.
-   * @param id resource enum id.
-   * @return a texture reference from the resource map.
+   * @param id resource enum id, must be preloaded or acquired by the non-const get.
+   * @return a texture reference.
+   * @remark Doesn't load, safe to call from the render thread
    */
   const sf::Texture & get(Textures::ID id) const;
-private:
   /**
-   * @brief insert a resource to resource map.
-   * @param id, resource enum id.
-   * @return  a reference to found texture.
+   * @return Returns textures of the level entities and projectiles, the default preload
    */
-  void insertResource(Textures::ID id, std::unique_ptr<sf::Texture> &resource);
-
-  /**
-   * @brief try load a texture from a filename to resource map. This function use @see insertResource()
-   * @param id resource enum id.
-   * @param filename file path to resource
-   */
-  void load(Textures::ID id, const std::string& filename);
-
-  std::map<Textures::ID,std::unique_ptr<sf::Texture>> resourceMap; /**< A map containing Texture ID as a key and SFML texture as a value is pointer to texture. Map is used over vector, because */
+  static std::vector<Textures::ID> unitTextures();
+private:
+  std::array<TextureHandle, Textures::id_end> textures; /**< Handles of the acquired textures, indexed by id */
 
 };
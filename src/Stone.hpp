@@ -24,6 +24,7 @@ class Stone : public Entity {
    *   @param b stones body for collisions
    *   @param t stones texture
    *   @param position Place as vector where stone is created
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Stone(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position);
+  Stone(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 };
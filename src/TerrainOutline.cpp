@@ -0,0 +1,231 @@
+/**
+  *   @file TerrainOutline.cpp
+  *   @brief Source code for merging terrain rectangles
+  */
+
+#include "TerrainOutline.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+  /*  Union find root with path halving */
+  std::size_t FindRoot(std::vector<std::size_t> &parent, std::size_t i)
+  {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  }
+
+  bool IsEmpty(const TerrainRect &rect)
+  {
+    return rect.width <= 0 || rect.height <= 0;
+  }
+
+  bool Touches(const TerrainRect &a, const TerrainRect &b)
+  {
+    return ! IsEmpty(a) && ! IsEmpty(b)
+           && a.left <= b.left + b.width && b.left <= a.left + a.width
+           && a.top <= b.top + b.height && b.top <= a.top + a.height;
+  }
+
+  std::size_t IndexOf(const std::vector<float> &coords, float value)
+  {
+    return std::lower_bound(coords.begin(), coords.end(), value) - coords.begin();
+  }
+
+  /**
+    *   @brief Trace outline of the rectangles of one group
+    *   @details Rectangle corners split the group to a grid of cells. Cell sides
+    *   between a covered and an uncovered cell are the outline edges. They are
+    *   directed so that the covered cell is on the left and then chained to loops.
+    */
+  std::vector<TerrainLoop> TraceGroup(const std::vector<TerrainRect> &rects, const std::vector<std::size_t> &group)
+  {
+    std::vector<float> xs;
+    std::vector<float> ys;
+    for (std::size_t r : group)
+    {
+      xs.push_back(rects[r].left);
+      xs.push_back(rects[r].left + rects[r].width);
+      ys.push_back(rects[r].top);
+      ys.push_back(rects[r].top + rects[r].height);
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    const int nx = static_cast<int>(xs.size());
+    const int ny = static_cast<int>(ys.size());
+    const int cells_x = nx - 1;
+    const int cells_y = ny - 1;
+    std::vector<bool> covered(static_cast<std::size_t>(cells_x) * cells_y, false);
+    for (std::size_t r : group)
+    {
+      int i0 = static_cast<int>(IndexOf(xs, rects[r].left));
+      int i1 = static_cast<int>(IndexOf(xs, rects[r].left + rects[r].width));
+      int j0 = static_cast<int>(IndexOf(ys, rects[r].top));
+      int j1 = static_cast<int>(IndexOf(ys, rects[r].top + rects[r].height));
+      for (int j = j0; j < j1; j++)
+      {
+        for (int i = i0; i < i1; i++)
+        {
+          covered[j * cells_x + i] = true;
+        }
+      }
+    }
+    auto is_covered = [&](int i, int j) {
+      return i >= 0 && j >= 0 && i < cells_x && j < cells_y && covered[j * cells_x + i];
+    };
+
+    // Directed boundary edges between grid vertices
+    struct Edge { int from_i, from_j, to_i, to_j; bool used; };
+    std::vector<Edge> edges;
+    for (int j = 0; j < cells_y; j++)
+    {
+      for (int i = 0; i < cells_x; i++)
+      {
+        if (! is_covered(i, j))
+        {
+          continue;
+        }
+        if (! is_covered(i, j - 1)) { edges.push_back({i, j, i + 1, j, false}); }
+        if (! is_covered(i + 1, j)) { edges.push_back({i + 1, j, i + 1, j + 1, false}); }
+        if (! is_covered(i, j + 1)) { edges.push_back({i + 1, j + 1, i, j + 1, false}); }
+        if (! is_covered(i - 1, j)) { edges.push_back({i, j + 1, i, j, false}); }
+      }
+    }
+
+    // A vertex starts at most two edges (two cells touching only by corner)
+    std::vector<int> outgoing(static_cast<std::size_t>(nx) * ny * 2, -1);
+    for (int e = 0; e < static_cast<int>(edges.size()); e++)
+    {
+      int vertex = edges[e].from_j * nx + edges[e].from_i;
+      outgoing[vertex * 2 + (outgoing[vertex * 2] < 0 ? 0 : 1)] = e;
+    }
+
+    std::vector<TerrainLoop> loops;
+    for (int start = 0; start < static_cast<int>(edges.size()); start++)
+    {
+      if (edges[start].used)
+      {
+        continue;
+      }
+      std::vector<std::pair<int, int>> vertices;
+      int current = start;
+      while (true)
+      {
+        Edge &edge = edges[current];
+        edge.used = true;
+        vertices.emplace_back(edge.from_i, edge.from_j);
+        int dx = edge.to_i - edge.from_i;
+        int dy = edge.to_j - edge.from_j;
+        // Prefer the left most turn, it keeps corner touching cells in separate loops
+        int vertex = edge.to_j * nx + edge.to_i;
+        int next = -1;
+        int best_turn = -2;
+        for (int k = 0; k < 2; k++)
+        {
+          int candidate = outgoing[vertex * 2 + k];
+          if (candidate < 0 || (edges[candidate].used && candidate != start))
+          {
+            continue;
+          }
+          int cx = edges[candidate].to_i - edges[candidate].from_i;
+          int cy = edges[candidate].to_j - edges[candidate].from_j;
+          int turn = dx * cy - dy * cx;
+          if (turn > best_turn)
+          {
+            best_turn = turn;
+            next = candidate;
+          }
+        }
+        if (next < 0 || next == start)
+        {
+          break;
+        }
+        current = next;
+      }
+
+      // Drop vertices in the middle of straight runs
+      TerrainLoop loop;
+      const std::size_t count = vertices.size();
+      for (std::size_t k = 0; k < count; k++)
+      {
+        const auto &prev = vertices[(k + count - 1) % count];
+        const auto &vertex = vertices[k];
+        const auto &next = vertices[(k + 1) % count];
+        bool straight = (prev.first == vertex.first && vertex.first == next.first)
+                        || (prev.second == vertex.second && vertex.second == next.second);
+        if (! straight)
+        {
+          loop.push_back({xs[vertex.first], ys[vertex.second]});
+        }
+      }
+      if (loop.size() >= 4)
+      {
+        loops.push_back(std::move(loop));
+      }
+    }
+    return loops;
+  }
+}
+
+std::vector<TerrainGroup> Terrain::merge(const std::vector<TerrainRect> &rects)
+{
+  const std::size_t count = rects.size();
+  std::vector<std::size_t> parent(count);
+  std::iota(parent.begin(), parent.end(), 0);
+
+  // Sweep from left to right, only rectangles overlapping on x can touch
+  std::vector<std::size_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&rects](std::size_t a, std::size_t b) { return rects[a].left < rects[b].left; });
+  for (std::size_t a = 0; a < count; a++)
+  {
+    const TerrainRect &first = rects[order[a]];
+    for (std::size_t b = a + 1; b < count && rects[order[b]].left <= first.left + first.width; b++)
+    {
+      if (Touches(first, rects[order[b]]))
+      {
+        parent[FindRoot(parent, order[a])] = FindRoot(parent, order[b]);
+      }
+    }
+  }
+
+  std::vector<TerrainGroup> groups;
+  std::vector<int> group_of_root(count, -1);
+  for (std::size_t r = 0; r < count; r++)
+  {
+    if (IsEmpty(rects[r]))
+    {
+      continue;
+    }
+    std::size_t root = FindRoot(parent, r);
+    if (group_of_root[root] < 0)
+    {
+      group_of_root[root] = static_cast<int>(groups.size());
+      groups.emplace_back();
+    }
+    groups[group_of_root[root]].rects.push_back(r);
+  }
+  for (TerrainGroup &group : groups)
+  {
+    group.loops = TraceGroup(rects, group.rects);
+  }
+  return groups;
+}
+
+std::size_t Terrain::countEdges(const std::vector<TerrainLoop> &loops)
+{
+  std::size_t edges = 0;
+  for (const TerrainLoop &loop : loops)
+  {
+    edges += loop.size();
+  }
+  return edges;
+}
@@ -0,0 +1,66 @@
+/**
+  *   @file TerrainOutline.hpp
+  *   @brief Merges terrain rectangles to outlines used as Box2D chain shapes
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include <cstddef>
+#include <vector>
+
+/**
+  *   @struct TerrainRect
+  *   @brief Axis aligned rectangle in pixels
+  */
+struct TerrainRect
+{
+  float left; /**< Upper left corner x coordinate */
+  float top; /**< Upper left corner y coordinate */
+  float width;
+  float height;
+};
+
+/**
+  *   @struct TerrainPoint
+  *   @brief Outline vertex in pixels
+  */
+struct TerrainPoint
+{
+  float x;
+  float y;
+};
+
+using TerrainLoop = std::vector<TerrainPoint>; /**< Closed outline, the last vertex connects to the first */
+
+/**
+  *   @struct TerrainGroup
+  *   @brief Connected rectangles and the outline of their union
+  */
+struct TerrainGroup
+{
+  std::vector<std::size_t> rects; /**< Indexes of the merged rectangles */
+  std::vector<TerrainLoop> loops; /**< Outer outline and outlines of possible holes */
+};
+
+namespace Terrain
+{
+  /**
+    *   @brief Merge overlapping and touching rectangles
+    *   @details Rectangles are grouped by contact and the union of each group is
+    *   traced to closed outlines. Internal edges between rectangles disappear
+    *   and collinear vertices are dropped, so a row of ground segments becomes
+    *   one four edge loop.
+    *   @param rects Rectangles to merge, empty ones are ignored
+    *   @return Returns one group per connected set of rectangles, in order of
+    *   their first rectangle
+    */
+  std::vector<TerrainGroup> merge(const std::vector<TerrainRect> &rects);
+
+  /**
+    *   @param loops Outlines
+    *   @return Returns the amount of edges in all loops
+    */
+  std::size_t countEdges(const std::vector<TerrainLoop> &loops);
+}
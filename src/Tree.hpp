@@ -24,6 +24,7 @@ class Tree : public Entity {
    *   @param b Trees body for collisions
    *   @param t Trees texture
    *   @param position Place as vector where tree is created
+   *   @param prototype Stats and team, see UnitPrototypes.cpp
    */
-  Tree(b2World &w,  b2Body *b, const sf::Texture &t, const sf::Vector2f &position);
+  Tree(b2World &w, b2Body *b, const sf::Texture &t, const sf::Vector2f &position, const Units::Prototype &prototype);
 };
@@ -0,0 +1,79 @@
+/**
+  *   @file UnitPrototypes.cpp
+  *   @brief Unit prototypes and their compilation to the prototype array
+  */
+
+#include "UnitPrototypes.hpp"
+#include "Plane.hpp"
+#include "Artillery.hpp"
+#include "Infantry.hpp"
+#include "Base.hpp"
+#include "Hangar.hpp"
+#include "Ground.hpp"
+#include "Stone.hpp"
+#include "Tree.hpp"
+#include "InvisibleWall.hpp"
+#include <array>
+
+namespace
+{
+  using namespace Units;
+  using Game::TYPE_ID;
+  using Game::TEAM_ID;
+
+  template <class T>
+  std::shared_ptr<Entity> Make(b2World& world, b2Body* body, const sf::Texture& texture,
+                               const sf::Vector2f& position, const Prototype& prototype,
+                               std::pmr::memory_resource& arena)
+  {
+    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(&arena), world, body, texture, position, prototype);
+  }
+
+  const float RADAR = 20.f; // meters
+
+  // Artillery doesn't move, so it is static like the structures
+  constexpr Prototype PROTOTYPES[] = {
+    // texture, factory, type, team, body, shape, density, gravity scale, sensor radius, scaled, scenery, speed, bullets, bombs, hit points
+    { Textures::BlueAirplane_alpha, Make<Plane>, TYPE_ID::airplane, TEAM_ID::blue, b2_dynamicBody, box, 1.f, 0.f, RADAR, false, false, 20.f, 400, 6, 20 },
+    { Textures::RedAirplane_alpha, Make<Plane>, TYPE_ID::airplane, TEAM_ID::red, b2_dynamicBody, box, 1.f, 0.f, RADAR, false, false, 20.f, 400, 6, 20 },
+    { Textures::BlueAntiAircraft_alpha, Make<Artillery>, TYPE_ID::antiaircraft, TEAM_ID::blue, b2_staticBody, box, 0.f, 1.f, RADAR, false, false, 0.f, 1000, 0, 30 },
+    { Textures::RedAntiAircraft_alpha, Make<Artillery>, TYPE_ID::antiaircraft, TEAM_ID::red, b2_staticBody, box, 0.f, 1.f, RADAR, false, false, 0.f, 1000, 0, 30 },
+    { Textures::BlueInfantry_alpha, Make<Infantry>, TYPE_ID::infantry, TEAM_ID::blue, b2_dynamicBody, box, 1000.f, 1.f, RADAR, false, false, 2.f, 200, 0, 3 },
+    { Textures::RedInfantry_alpha, Make<Infantry>, TYPE_ID::infantry, TEAM_ID::red, b2_dynamicBody, box, 1000.f, 1.f, RADAR, false, false, 2.f, 200, 0, 3 },
+    { Textures::BlueBase_alpha, Make<Base>, TYPE_ID::base, TEAM_ID::blue, b2_staticBody, box, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 40 },
+    { Textures::RedBase_alpha, Make<Base>, TYPE_ID::base, TEAM_ID::red, b2_staticBody, box, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 40 },
+    { Textures::BlueHangar_alpha, Make<Hangar>, TYPE_ID::hangar, TEAM_ID::blue, b2_staticBody, box, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 40 },
+    { Textures::RedHangar_alpha, Make<Hangar>, TYPE_ID::hangar, TEAM_ID::red, b2_staticBody, box, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 40 },
+    { Textures::Tree_alpha, Make<Tree>, TYPE_ID::tree, TEAM_ID::all_friend, b2_staticBody, box, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 50 },
+    { Textures::Rock_alpha, Make<Stone>, TYPE_ID::rock, TEAM_ID::all_friend, b2_staticBody, box, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 100 },
+    { Textures::Ground_alpha, Make<Ground>, TYPE_ID::ground, TEAM_ID::all_friend, b2_staticBody, terrain, 0.f, 1.f, 0.f, true, true, 0.f, 0, 0, 99999 },
+    { Textures::InvisibleWall_alpha, Make<InvisibleWall>, TYPE_ID::invisible_wall, TEAM_ID::all_friend, b2_staticBody, terrain, 0.f, 1.f, 0.f, false, true, 0.f, 0, 0, 99999 },
+  };
+
+  using Table = std::array<Prototype, Textures::id_end>;
+
+  constexpr Table Compile()
+  {
+    Table table{};
+    for (auto& prototype : table)
+    {
+      prototype.factory = nullptr;
+    }
+    for (const Prototype& prototype : PROTOTYPES)
+    {
+      table[prototype.texture] = prototype;
+    }
+    return table;
+  }
+
+  constexpr Table TABLE = Compile();
+}
+
+const Prototype* Units::get(Textures::ID id)
+{
+  if (id < 0 || id >= Textures::id_end || TABLE[id].factory == nullptr)
+  {
+    return nullptr;
+  }
+  return &TABLE[id];
+}
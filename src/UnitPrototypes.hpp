@@ -0,0 +1,82 @@
+/**
+  *   @file UnitPrototypes.hpp
+  *   @brief Prototype table of the entities that can be placed in a level
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <memory_resource>
+
+class Entity;
+
+/**
+  *   @namespace Units
+  *   @brief Body, stats and entity class of every level entity
+  *   @details The prototypes in UnitPrototypes.cpp are compiled to a flat
+  *   array indexed by Textures::ID when the program is compiled. World and
+  *   PhysicsWorld create every entity from its prototype, so a new unit only
+  *   needs a new row.
+  */
+namespace Units
+{
+  struct Prototype;
+
+  /**
+    *   @brief Construct the entity of a prototype
+    *   @param world Box2D world of the body
+    *   @param body Body created from the prototype
+    *   @param texture Texture of the prototype
+    *   @param position Sprite position
+    *   @param prototype Prototype of the entity
+    *   @param arena Memory of the entity and its reference count
+    *   @return Returns the entity, user data of the body isn't set
+    */
+  using Factory = std::shared_ptr<Entity> (*)(b2World& world, b2Body* body, const sf::Texture& texture,
+                                              const sf::Vector2f& position, const Prototype& prototype,
+                                              std::pmr::memory_resource& arena);
+
+  /**
+    *   @brief Fixture shape of a prototype
+    */
+  enum Shape
+  {
+    box, /**< Box of the level size */
+    terrain /**< Box is merged to the terrain body, the body has no fixtures */
+  };
+
+  /**
+    *   @struct Prototype
+    *   @brief Everything needed to spawn one kind of entity
+    */
+  struct Prototype
+  {
+    Textures::ID texture; /**< Texture, also the entity type in the level file */
+    Factory factory; /**< Constructs the entity class */
+    Game::TYPE_ID type;
+    Game::TEAM_ID team;
+    b2BodyType body; /**< Cheapest body type the unit needs, only moving units are dynamic */
+    Shape shape;
+    float density; /**< Fixture density, mass is area * density */
+    float gravity_scale;
+    float sensor_radius; /**< Radar sensor radius in meters, 0 creates no sensor */
+    bool scaled; /**< Sprite is stretched to the size in the level file */
+    bool scenery; /**< Never moves or changes, drawn to the cached background layer */
+    float speed; /**< Maximum speed */
+    int bullets;
+    int bombs;
+    int hit_points;
+  };
+
+  /**
+    *   @brief Get prototype of a texture
+    *   @param id Texture id
+    *   @return Returns nullptr if the texture isn't a level entity
+    */
+  const Prototype* get(Textures::ID id);
+}
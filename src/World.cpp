@@ -4,12 +4,26 @@
   */
 
 #include "World.hpp"
+#include <chrono>
+
+namespace
+{
+	/*  Texture of a reinforcement unit  */
+	Textures::ID UnitTexture(Game::TEAM_ID team, Game::TYPE_ID type)
+	{
+		bool red = team == Game::TEAM_ID::red;
+		if (type == Game::TYPE_ID::airplane) {
+			return red ? Textures::RedAirplane_alpha : Textures::BlueAirplane_alpha;
+		}
+		return red ? Textures::RedInfantry_alpha : Textures::BlueInfantry_alpha;
+	}
+}
 
 /*  Class World  */
 
 /*  Constructor  */
 
-World::World(sf::RenderWindow &main_window, ResourceManager &_resources) :  resources(_resources), window(main_window) {}
+World::World(sf::RenderWindow &main_window, ResourceManager &_resources) :  resources(_resources), window(main_window), projectiles(pworld.get_world()) {}
 
 /*  Parse level .txt file and create world's entities  */
 
@@ -17,87 +31,44 @@ bool World::read_level(std::string& filename, Game::GameMode game_mode) {
 	//entity type; x; y; orientation; width; height
 	// init score
 	score = 0;
-	double x, y, width, height;
-  	int orientation;
-  	std::string type;
-	std::ifstream file(filename);
-	if (file.is_open()) {
-		clear_all();
-		bool comments_read = false;
-		std::string line;
-		while(getline(file,line)) {
-			if (! comments_read) {
-				if (line.find("*/") != std::string::npos) {
-					comments_read = true;
-				}
-			}
-			else {
-				std::istringstream temp_stream(line);
-				std::string split_str;
-				int i = 0;
-
-				while(getline(temp_stream, split_str, ';')) {
-					try {
-						switch (i) {
-						  case 0:
-			                type = split_str;
-			                break;
-			              case 1:
-			                x = std::stod(split_str);
-			                break;
-			              case 2:
-			                y = std::stod(split_str);
-			                break;
-			              case 3:
-			                orientation = std::stoi(split_str);
-			                break;
-			              case 4:
-			                width = std::stod(split_str);
-			                break;
-			              case 5:
-			                height = std::stod(split_str);
-			                break;
-						}
-						i++;
-					}
-
-					catch (std::exception &e) {
-						std::cout << e.what() << std::endl;
-						//clear all
-						return false;
-					}
-				}
-
-				if (i != 6) {
-					//failed
-					clear_all();
-					return false;
-				}
-				
-					//all ok
-					if (type == "InvisibleWall") {
-					        b2Body* body = pworld.create_body_static(x+(width/2), y+(height/2), width, height, Game::TYPE_ID::invisible_wall);
-						std::shared_ptr<Entity> entity = std::make_shared<InvisibleWall>(*pworld.get_world(), body, resources.get(Textures::alphaTextures.at("InvisibleWall")), sf::Vector2f(x,y));
-						entity->setType(Textures::InvisibleWall_alpha);
-						body->SetUserData(entity.get());
-						objects.push_back(entity);
-					}
-					try {
-						Textures::ID id = Textures::alphaTextures.at(type);
-						if (x+width < Game::WIDTH) {
-							x += width/2;
-							y += height/2;
-							create_entity(id, x, y, orientation, width, height, sf::Vector2f(1.0f, 0.0f), game_mode);
-						}
-
-					}
-					catch (const std::out_of_range& er) {
-
-					}
-				
-			}
+	LevelParser parser;
+	if (! parser.open(filename)) {
+		parser.printDiagnostics(std::cout, filename);
+		return false;
+	}
+	clear_all();
+	level_width = Game::WIDTH;
+	LevelRecord record;
+	while (parser.next(record)) {
+		double x = record.x;
+		double y = record.y;
+		double width = record.width;
+		double height = record.height;
+		if (x + width > level_width) {
+			level_width = x + width;
+		}
+		auto found = Textures::alphaTextures.find(record.type);
+		if (found != Textures::alphaTextures.end()) {
+			x += width/2;
+			y += height/2;
+			create_entity(found->second, x, y, record.orientation, width, height, game_mode);
 		}
 	}
+	if (parser.failed()) {
+		// malformed line, don't start a partial level
+		parser.printDiagnostics(std::cout, filename);
+		clear_all();
+		return false;
+	}
+
+	compile_terrain();
+	settle_on_ground();
+	prewarm_reinforcements();
+	rebuild_minimap();
+	// contacts are only known after stepping, GameEngine reports them per level
+	std::cout << "Terrain: " << stats.terrain_boxes << " ground and wall boxes (one proxy each) merged to "
+	          << terrain_fixtures.size() << " fixtures (" << stats.terrain_proxies << " proxies)" << std::endl;
+	AI::set_level_width(level_width);
 
 	return true;
 }
@@ -106,260 +77,246 @@ bool World::read_level(std::string& filename, Game::GameMode game_mode) {
 /*  Clears the world  */
 
 void World::clear_all() {
+	chunks.reset();
 	objects.clear();
 	player_planes.clear();
-	for (b2Body* b = pworld.get_world()->GetBodyList(); b != nullptr; b = b->GetNext()) {
-		pworld.get_world()->DestroyBody(b);
-}
+	destroyed_entity_bodies.clear();
+	projectiles.clear();
+	particles.clear();
+	minimap.reset(sf::Vector2f(Game::WIDTH, Game::HEIGHT));
+	cooldowns.reset();
+	counters.reset();
+	reinforcement_targets.reset();
+	hangars.clear();
+	reinforcement_pools.clear();
+	terrain_pieces.clear();
+	terrain_fixtures.clear();
+	terrain_body = nullptr;
+	scenery_dirty.clear();
+	scenery_changed = true;
+	scenery_level++;
+	stats = WorldStats();
+	// no entity is left, free their memory and all bodies at once
+	entity_arena.release();
+	pworld.reset();
+	projectiles.setWorld(pworld.get_world());
 }
 
-/*  Create entity  */
-
-bool World::create_entity(Textures::ID id, double x, double y, int orientation, double width, double height, sf::Vector2f direct, Game::GameMode game_mode) {
-	sf::Texture &tex = resources.get(id);
-	sf::Vector2f pos(x,y);
-	b2Body* body;
-	std::shared_ptr<Entity> entity;
-
-	switch(id) {
-		case Textures::BlueAirplane_alpha: {
-		        body = pworld.create_body_dynamic(x, y, width, height,1);
-			entity = std::make_shared<Plane>(*pworld.get_world(), body, tex, pos, direct, Game::TEAM_ID::blue);
-			entity->setType(Textures::BlueAirplane_alpha);
-			body->SetUserData(entity.get());
-			body->SetGravityScale(0); //gravity 0 for plane
-			// add BlueAirplane to player_planes[0] (controlled by player not by AI)
-                        if (orientation == 0)
-                        {
-                          entity->setDirection({-1.f,0});
-                          entity->faceLeft();
-                        }
-			player_planes.push_front((std::move(entity)));
-			break;
-		}
-		case Textures::BlueAntiAircraft_alpha: {
-		        body = pworld.create_body_dynamic(x, y, width, height, 1);
-			entity = std::make_shared<Artillery>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::blue);
-			entity->setType(Textures::BlueAntiAircraft_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::BlueBase_alpha: {
-		        body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::base);
-			entity = std::make_shared<Base>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::blue);
-			entity->setType(Textures::BlueBase_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::BlueHangar_alpha: {
-		        body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::hangar);
-			entity = std::make_shared<Hangar>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::blue);
-			entity->setType(Textures::BlueHangar_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::BlueInfantry_alpha: {
-		        body = pworld.create_body_dynamic(x, y, width, height, 1000);
-			entity = std::make_shared<Infantry>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::blue);
-			entity->setType(Textures::BlueInfantry_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::Ground_alpha: {
-		        body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::ground);
-			entity = std::make_shared<Ground>(*pworld.get_world(), body, tex, pos);
-			entity->setType(Textures::Ground_alpha);
-			entity->setScale(width,height);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::RedAirplane_alpha: {
-			if (game_mode == Game::GameMode::SinglePlayer) {
-				// add RedAirplanes to the normal container (controlled by AI)
-			        body = pworld.create_body_dynamic(x, y, width, height, 1);
-				entity = std::make_shared<Plane>(*pworld.get_world(), body, tex, pos, direct, Game::TEAM_ID::red);
-				entity->setType(Textures::RedAirplane_alpha);
-				body->SetUserData(entity.get());
-				body->SetGravityScale(0); //gravity 0 for plane
-                                if (orientation == 0)
-                                {
-                                  entity->setDirection({-1.f,0});
-                                  entity->faceLeft();
-                                }
-				objects.push_back(std::move(entity));
+/*  Store the world to snapshot  */
+
+void World::take_snapshot(WorldSnapshot& snapshot, const std::string& filename, Game::GameMode game_mode) {
+	snapshot.level_file = filename;
+	snapshot.game_mode = game_mode;
+	snapshot.level_width = level_width;
+	snapshot.entities.clear();
+	snapshot.entities.reserve(player_planes.size() + objects.size());
+	snapshot.terrain.clear();
+
+	auto store = [&snapshot](Entity& entity, bool player_plane) {
+		EntitySnapshot entity_snapshot;
+		entity_snapshot.type = entity.getType();
+		entity_snapshot.player_plane = player_plane;
+		entity_snapshot.state = entity.getState();
+
+		b2Body* body = entity.getB2Body();
+		b2BodyDef& def = entity_snapshot.body;
+		def.type = body->GetType();
+		def.position = body->GetPosition();
+		def.angle = body->GetAngle();
+		def.linearVelocity = body->GetLinearVelocity();
+		def.angularVelocity = body->GetAngularVelocity();
+		def.linearDamping = body->GetLinearDamping();
+		def.angularDamping = body->GetAngularDamping();
+		def.allowSleep = body->IsSleepingAllowed();
+		def.awake = body->IsAwake();
+		def.fixedRotation = body->IsFixedRotation();
+		def.bullet = body->IsBullet();
+		def.active = body->IsActive();
+		def.gravityScale = body->GetGravityScale();
+
+		for (b2Fixture* fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext()) {
+			FixtureSnapshot fixture_snapshot;
+			fixture_snapshot.shape_type = fixture->GetType();
+			if (fixture_snapshot.shape_type == b2Shape::e_polygon) {
+				fixture_snapshot.polygon = *static_cast<b2PolygonShape*>(fixture->GetShape());
+			}
+			else if (fixture_snapshot.shape_type == b2Shape::e_circle) {
+				fixture_snapshot.circle = *static_cast<b2CircleShape*>(fixture->GetShape());
 			}
 			else {
-				// Add RedAirplane to player_planes container
-				if (player_planes.size() == 1) {
-					if (player_planes[0]->getType() == Textures::ID::BlueAirplane_alpha) {
-						// only one RedAirplane is alowed and it needs to be at player_planes[1]
-					        body = pworld.create_body_dynamic(x, y, width, height, 1);
-						entity = std::make_shared<Plane>(*pworld.get_world(), body, tex, pos, direct, Game::TEAM_ID::red);
-						entity->setType(Textures::RedAirplane_alpha);
-						body->SetUserData(entity.get());
-						body->SetGravityScale(0); //gravity 0 for plane
-                                                if (orientation == 0)
-                                                {
-                                                  entity->setDirection({-1.f,0});
-                                                  entity->faceLeft();
-                                                }
-						player_planes.push_back(std::move(entity));
-					}
-				}
-				else if (player_planes.empty()) {
-
-				        body = pworld.create_body_dynamic(x, y, width, height,1 );
-					entity = std::make_shared<Plane>(*pworld.get_world(), body, tex, pos, direct, Game::TEAM_ID::red);
-					entity->setType(Textures::RedAirplane_alpha);
-					body->SetUserData(entity.get());
-					body->SetGravityScale(0); //gravity 0 for plane
-                                        if (orientation == 0)
-                                        {
-                                          entity->setDirection({-1.f,0});
-                                          entity->faceLeft();
-                                        }
-					player_planes.push_back(std::move(entity));
-				}
+				// Entities use only boxes and radar circles
+				continue;
 			}
-			break;
-		}
-		case Textures::RedAntiAircraft_alpha: {
-		        body = pworld.create_body_dynamic(x, y, width, height,1);
-			entity = std::make_shared<Artillery>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::red);
-			entity->setType(Textures::RedAntiAircraft_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::RedBase_alpha: {
-		        body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::base);
-			entity = std::make_shared<Base>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::red);
-			entity->setType(Textures::RedBase_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::RedHangar_alpha: {
-		        body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::hangar);
-			entity = std::make_shared<Hangar>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::red);
-			entity->setType(Textures::RedHangar_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::RedInfantry_alpha: {
-		        body = pworld.create_body_dynamic(x, y, width, height, 1000);
-			entity = std::make_shared<Infantry>(*pworld.get_world(), body, tex, pos, Game::TEAM_ID::red);
-			entity->setType(Textures::RedInfantry_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::Rock_alpha: {
-			body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::rock);
-			entity = std::make_shared<Stone>(*pworld.get_world(), body, tex, pos);
-			entity->setType(Textures::Rock_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-		case Textures::Tree_alpha: {
-			body = pworld.create_body_static(x, y, width, height, Game::TYPE_ID::tree);
-			entity = std::make_shared<Tree>(*pworld.get_world(), body, tex, pos);
-			entity->setType(Textures::Tree_alpha);
-			body->SetUserData(entity.get());
-			break;
-		}
-	        case Textures::InvisibleWall_alpha:
-		  {
-		    // created before. SKIP
-		    break;
-		  }
-		default:
-		        std::cout << "id not found" << std::endl;
-			break;
-	}
-
-        if (id != Textures::RedAirplane_alpha && id != Textures::BlueAirplane_alpha &&  orientation == 0)
-        {
-          entity->setDirection({-1.f,0});
-          entity->faceLeft();
-        }
-
-	if (entity && (id != Textures::BlueAirplane_alpha) && (id != Textures::RedAirplane_alpha)) {
-	  objects.push_back(std::move(entity));
-	  return true;
-	}
-	//entity was already added
-	
-		return false;
-		
+			fixture_snapshot.density = fixture->GetDensity();
+			fixture_snapshot.friction = fixture->GetFriction();
+			fixture_snapshot.restitution = fixture->GetRestitution();
+			fixture_snapshot.sensor = fixture->IsSensor();
+			fixture_snapshot.filter = fixture->GetFilterData();
+			entity_snapshot.fixtures.push_back(fixture_snapshot);
+		}
+		snapshot.entities.push_back(std::move(entity_snapshot));
+	};
+
+	for (auto& it : player_planes) {
+		store(*it, true);
+	}
+	for (auto& it : objects) {
+		store(*it, false);
+	}
+
+	// terrain body has no entity, store the boxes it was merged from
+	std::unordered_map<Entity*, std::size_t> index_of;
+	for (std::size_t i = 0; i < objects.size(); i++) {
+		index_of[objects[i].get()] = player_planes.size() + i;
+	}
+	for (const auto& piece : terrain_pieces) {
+		snapshot.terrain.push_back({piece.rect, index_of.at(piece.entity)});
+	}
 }
 
-/*  Remove entity  */
+/*  Rebuild the world from snapshot  */
 
-bool World::remove_bullet(Entity *bullet, Entity *entity) {
-	for (auto & object : objects) {
-		std::list<std::shared_ptr<Entity>>& bullets_list = object->get_active_bullets();
-		for (auto item = bullets_list.begin(); item != bullets_list.end(); item++) {
-			if ((item->get() == bullet) && (bullet->getOwner() != entity)) {
-				// raw pointers match, erase bullet
-				b2Body* body = (*item)->getB2Body();
-				body->SetUserData(nullptr);
-				bullets_list.erase(item);
-				// remove body also
-				pworld.remove_body(body);
-				return true;
-			}
-		}
+bool World::restore_snapshot(const WorldSnapshot& snapshot) {
+	if (! snapshot.valid()) {
+		return false;
 	}
-	for (auto & player_plane : player_planes) {
-		// Check also player_planes bullets
-		std::list<std::shared_ptr<Entity>>& bullets_list = player_plane->get_active_bullets();
-		for (auto item = bullets_list.begin(); item != bullets_list.end(); item++) {
-			if ((item->get() == bullet) && (bullet->getOwner() != entity)) {
-				// raw pointers match, erase bullet
-				b2Body* body = (*item)->getB2Body();
-				body->SetUserData(nullptr);
-				bullets_list.erase(item);
-				// remove body also
-				pworld.remove_body(body);
-				return true;
+	clear_all();
+	score = 0;
+	level_width = snapshot.level_width;
+	b2World* b2world = pworld.get_world();
+	std::vector<Entity*> restored;
+	restored.reserve(snapshot.entities.size());
+
+	for (const auto& entity_snapshot : snapshot.entities) {
+		b2Body* body = b2world->CreateBody(&entity_snapshot.body);
+		for (const auto& fixture_snapshot : entity_snapshot.fixtures) {
+			b2FixtureDef def;
+			if (fixture_snapshot.shape_type == b2Shape::e_polygon) {
+				def.shape = &fixture_snapshot.polygon;
 			}
+			else {
+				def.shape = &fixture_snapshot.circle;
+			}
+			def.density = fixture_snapshot.density;
+			def.friction = fixture_snapshot.friction;
+			def.restitution = fixture_snapshot.restitution;
+			def.isSensor = fixture_snapshot.sensor;
+			def.filter = fixture_snapshot.filter;
+			body->CreateFixture(&def);
+		}
+
+		std::shared_ptr<Entity> entity = instantiate(entity_snapshot.type, body, entity_snapshot.state.position);
+		entity->setState(entity_snapshot.state);
+		attach_entity(entity.get());
+		body->SetUserData(entity.get());
+		restored.push_back(entity.get());
+		if (entity_snapshot.player_plane) {
+			player_planes.push_back(std::move(entity));
 		}
+		else {
+			chunks.insert(entity.get());
+			objects.push_back(std::move(entity));
+		}
+	}
+	for (const auto& terrain_snapshot : snapshot.terrain) {
+		terrain_pieces.push_back({terrain_snapshot.rect, restored[terrain_snapshot.entity]});
 	}
+	compile_terrain();
+	prewarm_reinforcements();
+	rebuild_minimap();
+	AI::set_level_width(level_width);
+	return true;
+}
 
-	return false;
+/*  Construct entity matching the texture id  */
+
+std::shared_ptr<Entity> World::instantiate(Textures::ID id, b2Body* body, const sf::Vector2f& pos) {
+	const Units::Prototype* prototype = Units::get(id);
+	return prototype->factory(*pworld.get_world(), body, resources.get(id), pos, *prototype, entity_arena);
+}
+
+/*  Create entity  */
+
+bool World::create_entity(Textures::ID id, double x, double y, int orientation, double width, double height, Game::GameMode game_mode) {
+	const Units::Prototype* prototype = Units::get(id);
+	if (prototype == nullptr) {
+		std::cout << "id not found" << std::endl;
+		return false;
+	}
+	// BlueAirplane is player_planes[0], in multiplayer one RedAirplane is player_planes[1]
+	bool player_plane = id == Textures::BlueAirplane_alpha
+		|| (id == Textures::RedAirplane_alpha && game_mode != Game::GameMode::SinglePlayer);
+	if (player_plane && id == Textures::RedAirplane_alpha && ! (player_planes.empty()
+		|| (player_planes.size() == 1 && player_planes[0]->getType() == Textures::BlueAirplane_alpha))) {
+		return false;
+	}
+
+	sf::Vector2f pos(x,y);
+	b2Body* body = pworld.create_body(*prototype, x, y, width, height);
+	std::shared_ptr<Entity> entity = instantiate(id, body, pos);
+	body->SetUserData(entity.get());
+	if (prototype->scaled) {
+		entity->setScale(width,height);
+	}
+	if (prototype->shape == Units::terrain) {
+		terrain_pieces.push_back({{(float)(x - width/2), (float)(y - height/2), (float)width, (float)height}, entity.get()});
+	}
+	if (orientation == 0) {
+		entity->setDirection({-1.f,0});
+		entity->faceLeft();
+	}
+	attach_entity(entity.get());
+
+	if (! player_plane) {
+		chunks.insert(entity.get());
+		objects.push_back(std::move(entity));
+	}
+	else if (id == Textures::BlueAirplane_alpha) {
+		player_planes.push_front(std::move(entity));
+	}
+	else {
+		player_planes.push_back(std::move(entity));
+	}
+	return true;
 }
+
+/*  Remove entity  */
+
 bool World::remove_entity(Entity *entity)
 {
 		for (auto it = objects.begin(); it != objects.end(); it++) {
 			if (it->get() == entity) {
 				// raw pointers match, erase entity from the vector
-				std::list<std::shared_ptr<Entity>>& bullets_list = (*it)->get_active_bullets();
-				for (auto item = bullets_list.begin(); item != bullets_list.end(); ) {
-						// remove all entity's bullets
-						b2Body* body = (*item)->getB2Body();
-						body->SetUserData(nullptr);
-						item = bullets_list.erase(item);
-						// remove body also
-						pworld.remove_body(body);
-					}
+				projectiles.removeOwner(it->get());
+				cooldowns.release((*it)->getCooldown());
+				counters.remove((*it)->getTeamId(), (*it)->getTypeId());
+				hangars.erase(std::remove(hangars.begin(), hangars.end(), it->get()), hangars.end());
 				b2Body* body = (*it)->getB2Body();
 				body->SetUserData(nullptr);
+				chunks.remove(it->get());
+				minimap.remove((*it)->getMinimapCell(), (*it)->getTeamId());
+				if (Units::get((*it)->getType())->scenery) {
+					// only this region of the background layer is drawn again
+					scenery_dirty.push_back((*it)->getSpriteState().getBounds());
+					scenery_changed = true;
+				}
+				bool terrain = remove_terrain_piece(it->get());
 				objects.erase(it);
 				pworld.remove_body(body);
+				if (terrain) {
+					compile_terrain();
+					rebuild_minimap();
+				}
 				return true;
 			}
 		}
 		// go through also player_planes
 		for (auto it = player_planes.begin(); it != player_planes.end(); it++) {
 			if (it->get() == entity) {
-				// get player's bullets
-				std::list<std::shared_ptr<Entity>>& bullets_list = (*it)->get_active_bullets();
-				for (auto item = bullets_list.begin(); item != bullets_list.end(); ) {
-						// remove all entity's bullets
-						b2Body* body = (*item)->getB2Body();
-						body->SetUserData(nullptr);
-						item = bullets_list.erase(item);
-						// remove body also
-						pworld.remove_body(body);
-					}
+				projectiles.removeOwner(it->get());
+				cooldowns.release((*it)->getCooldown());
+				counters.remove((*it)->getTeamId(), (*it)->getTypeId());
+				minimap.remove((*it)->getMinimapCell(), (*it)->getTeamId());
 				b2Body* body = (*it)->getB2Body();
 				body->SetUserData(nullptr);
 				player_planes.erase(it);
@@ -381,9 +338,21 @@ GameResult World::update(Game::GameMode game_mode) {
   	int32 velocityIterations = 8;   //how strongly to correct velocity
   	int32 positionIterations = 3;   //how strongly to correct position
 
+	cooldowns.advance();
 	pworld.get_world()->Step(timeStep, velocityIterations, positionIterations);
-
-	for (auto &it : objects) {
+	projectile_hits.clear();
+	projectiles.step(timeStep, level_width, projectile_hits);
+	particles.step(timeStep);
+	stats.bodies = pworld.get_world()->GetBodyCount();
+	stats.proxies = pworld.get_world()->GetProxyCount();
+	stats.contacts = pworld.get_world()->GetContactCount();
+	stats.touching_contacts = 0;
+	stats.ticks++;
+	stats.total_contacts += stats.contacts;
+	stats.peak_contacts = std::max(stats.peak_contacts, stats.contacts);
+
+	// entities of inactive chunks have no contacts
+	for (Entity *it : chunks.getActiveEntities()) {
 		it->erase_surroundings();
 	}
 	for (auto &it : player_planes) {
@@ -393,16 +362,18 @@ GameResult World::update(Game::GameMode game_mode) {
 	//collision detection
 	for (b2Contact* contact = pworld.get_world()->GetContactList(); contact != nullptr;  contact = contact->GetNext()) {
 		if (contact->IsTouching()){
+			stats.touching_contacts++;
 			b2Fixture* a_fixture = contact->GetFixtureA();
 			b2Fixture* b_fixture = contact->GetFixtureB();
 
-			b2Body* a_body = a_fixture->GetBody();
-			b2Body* b_body = b_fixture->GetBody();
-
-			Entity* a_entity = findEntity(a_body);
-			Entity* b_entity = findEntity(b_body);
+			// terrain fixtures map back to their ground or wall entity
+			Entity* a_entity = findEntity(a_fixture);
+			Entity* b_entity = findEntity(b_fixture);
 
 			if (a_entity != nullptr && b_entity != nullptr) {
+				// entity's own body, for terrain this isn't the fixture's body
+				b2Body* a_body = a_entity->getB2Body();
+				b2Body* b_body = b_entity->getB2Body();
 				bool a_sensor = a_fixture->IsSensor();
 				bool b_sensor = b_fixture->IsSensor();
 
@@ -418,98 +389,15 @@ GameResult World::update(Game::GameMode game_mode) {
 				}
 
 				else if ((!a_sensor) && (!b_sensor)) {
-					if (a_entity->getType() == Textures::Bullet_alpha) {
-						if (b_entity->getType() == Textures::Bullet_alpha) {
-							// remove both bullets
-							destroyed_bullet_bodies.push_back(b_body);
-							// remove a_entity which is a bullet
-							destroyed_bullet_bodies.push_back(a_body);
-						}
-						else if (a_entity->getOwner() != b_entity){
-							if (b_entity->damage(10)) {
-								Entity* owner = a_entity->getOwner();
-								if ( owner->getTypeId() == Game::TYPE_ID::airplane)
-								{
-									auto* owner_plane = dynamic_cast<Plane*>(owner);
-									owner_plane->addToKillList(b_entity);
-								}
-								destroyed_entity_bodies.push_back(b_body);
-							}
-							// remove a_entity which is a bullet
-							destroyed_bullet_bodies.push_back(a_body);
-						}
-
-
-					}
-					else if (b_entity->getType() == Textures::Bullet_alpha) {
-
-						if (b_entity->getOwner() != a_entity) {
-							if (a_entity->damage(10)) {
-
-								// A is killed by the owner of bullet B
-								Entity* owner = b_entity->getOwner();
-								if ( owner->getTypeId() == Game::TYPE_ID::airplane)
-								{
-									auto* owner_plane = dynamic_cast<Plane*>(owner);
-									owner_plane->addToKillList(a_entity);
-								}
-								destroyed_entity_bodies.push_back(a_body);
-							}
-							// remove b_entity which is a bullet
-							destroyed_bullet_bodies.push_back(b_body);
-						}
-
-
-					}
-					else if (a_entity->getTypeId() == Game::TYPE_ID::airplane) {
-						if (b_entity->getTypeId() == Game::TYPE_ID::ground) {
-							// airplane destroyed
-							destroyed_entity_bodies.push_back(a_body);
-						}
-						else if (b_entity->getTypeId() == Game::TYPE_ID::airplane)
-						{
-							// damage both planes
-							if (a_entity->damage(10)){
-								destroyed_entity_bodies.push_back(a_body);
-							}
-							if (b_entity->damage(10)){
-								destroyed_entity_bodies.push_back(b_body);
-							}
-						}
-						else if (b_entity->getTypeId() == Game::TYPE_ID::infantry) {
-							// destroy infantry and damage plane
-							destroyed_entity_bodies.push_back(b_body);
-							if (a_entity->damage(10)) {
-								destroyed_entity_bodies.push_back(a_body);
-							}
-						}
+					// effects of the contact, see CollisionResponse.cpp
+					const Collision::Effect& on_a = Collision::getEffect(a_entity->getTypeId(), b_entity->getTypeId());
+					const Collision::Effect& on_b = Collision::getEffect(b_entity->getTypeId(), a_entity->getTypeId());
+					if (on_a.handler(*a_entity, on_a.amount)) {
+						destroyed_entity_bodies.push_back(a_body);
 					}
-					else if (b_entity->getTypeId() == Game::TYPE_ID::airplane) {
-						if (a_entity->getTypeId() == Game::TYPE_ID::ground) {
-							// airplane destroyed
-							destroyed_entity_bodies.push_back(b_body);
-						}
-						else if (a_entity->getTypeId() == Game::TYPE_ID::airplane)
-						{
-							// damage both planes
-							if (b_entity->damage(10)) {
-								destroyed_entity_bodies.push_back(b_body);
-							}
-							if (a_entity->damage(10)) {
-								destroyed_entity_bodies.push_back(a_body);
-							}
-						}
-						else if (a_entity->getTypeId() == Game::TYPE_ID::infantry) {
-							// destroy infantry and damage plane
-							destroyed_entity_bodies.push_back(a_body);
-							if (b_entity->damage(10)) {
-								destroyed_entity_bodies.push_back(b_body);
-							}
-						}
+					if (on_b.handler(*b_entity, on_b.amount)) {
+						destroyed_entity_bodies.push_back(b_body);
 					}
-
-
-
 				}
 
 			}
@@ -520,31 +408,49 @@ GameResult World::update(Game::GameMode game_mode) {
 
 
 
-	// remove destroyed_bodies from the world
-	// bullets must be removed first because they are stored within other entities
-
-	// sort the list and remove dublicates so that no entity / bullet is removed twice
-	destroyed_bullet_bodies.sort();
-	destroyed_bullet_bodies.unique();
-	for (auto it : destroyed_bullet_bodies) {
-		auto* bullet = static_cast<Entity*>(it->GetUserData());
-		remove_bullet(bullet, bullet);
-	}
-	// clear all old pointers which have been removed
-	destroyed_bullet_bodies.clear();
+	apply_projectile_hits();
 
+	// remove destroyed_bodies from the world
+	// sort the list and remove dublicates so that no entity is removed twice
 	destroyed_entity_bodies.sort();
 	destroyed_entity_bodies.unique();
 	for (auto it : destroyed_entity_bodies) {
 		auto* entity = static_cast<Entity*>(it->GetUserData());
+		if (entity != nullptr) {
+			particles.emit(ParticleSystem::explosion, entity->getPosition());
+		}
 		remove_entity(entity);
 	}
 	destroyed_entity_bodies.clear();
+	stats.live_bullets = projectiles.size();
+	stats.live_particles = particles.size();
+	stats.particles_dropped = particles.getDroppedCount();
+	stats.bullets_expired = projectiles.getExpiredCount();
+	stats.bullets_out_of_bounds = projectiles.getOutOfBoundsCount();
 
-	//updating the world
-	for (const auto& it : objects) {
+	update_hangars();
+
+	// activate chunks near the player planes
+	std::vector<float> focus_x;
+	for (const auto& it : player_planes) {
+		focus_x.push_back(Game::TOPIXELS*it->getB2Body()->GetPosition().x);
+	}
+	chunks.update(focus_x);
+	stats.entities = objects.size() + player_planes.size();
+	stats.active_entities = chunks.getActiveEntities().size() + player_planes.size();
+	stats.active_bodies = 0;
+	for (b2Body* body = pworld.get_world()->GetBodyList(); body != nullptr; body = body->GetNext()) {
+		stats.active_bodies += body->IsActive() ? 1 : 0;
+	}
+	stats.total_active_entities += stats.active_entities;
+	stats.total_active_bodies += stats.active_bodies;
+
+	//updating the world, entities far away from the players are skipped
+	for (Entity *it : chunks.getActiveEntities()) {
+		// sprite is drawn from here to the new position until the next step
+		it->storePreviousTransform();
 		//1. send ai information
-                AI::get_action(*it, it->get_surroundings(), resources);
+                AI::get_action(*it, it->get_surroundings());
 		//do something with ai information
 
 		//2. update new positions
@@ -553,54 +459,95 @@ GameResult World::update(Game::GameMode game_mode) {
 		float y = Game::TOPIXELS*it->getB2Body()->GetPosition().y;
 		sf::Vector2f newpos(x,y);
 		it->setPos(newpos);
-
-		std::list<std::shared_ptr<Entity>> bullets = it->get_active_bullets();
-
-		for (const auto& b : bullets) {
-			float x = Game::TOPIXELS*b->getB2Body()->GetPosition().x;
-			float y = Game::TOPIXELS*b->getB2Body()->GetPosition().y;
-			sf::Vector2f newpos(x,y);
-			b->setPos(newpos);
-
-			b->drawTo(window);
-		}
+		// only a unit crossing to another cell changes the grid
+		it->setMinimapCell(minimap.move(it->getMinimapCell(), it->getTeamId(), newpos));
 
 		//set sfml sprite's angle from body's angle
 		//it->setRot(it->getB2Body().GetAngle()*RADTODEG);
-
-		it->drawTo(window);
 	}
 
-	// Draw player planes
 	for (const auto& it : player_planes) {
+		it->storePreviousTransform();
 		float x = Game::TOPIXELS*it->getB2Body()->GetPosition().x;
 		float y = Game::TOPIXELS*it->getB2Body()->GetPosition().y;
 		sf::Vector2f newpos(x,y);
 		it->setPos(newpos);
+		it->setMinimapCell(minimap.move(it->getMinimapCell(), it->getTeamId(), newpos));
+
+		//set sfml sprite's angle from body's angle
+		it->setRot(it->getB2Body()->GetAngle()*RADTODEG);
+	}
 
-		std::list<std::shared_ptr<Entity>> bullets = it->get_active_bullets();
+	// update the score
+	updateScore(game_mode);
+
+	return checkGameStatus(game_mode);
+}
 
-		for (const auto& b : bullets) {
-			float x = Game::TOPIXELS*b->getB2Body()->GetPosition().x;
-			float y = Game::TOPIXELS*b->getB2Body()->GetPosition().y;
-			sf::Vector2f newpos(x,y);
-			b->setPos(newpos);
+/*  Publish the drawn state  */
 
-			b->drawTo(window);
+void World::publish(RenderFrame& frame, const sf::FloatRect& visible) {
+	if (scenery_changed) {
+		update_scenery();
+	}
+	frame.scenery = scenery;
+	// entities outside the camera aren't drawn, scenery is in its own layer
+	chunks.collectVisible(visible.left, visible.left + visible.width, visible_entities);
+	stats.visible_entities = visible_entities.size();
+	stats.culled_entities = chunks.getActiveEntities().size() - visible_entities.size();
+	for (Entity *it : visible_entities) {
+		if (! Units::get(it->getType())->scenery) {
+			frame.sprites.push_back(it->getSpriteState());
 		}
+	}
+	for (const auto& it : player_planes) {
+		frame.sprites.push_back(it->getSpriteState());
+	}
+	projectiles.exportState(frame.projectiles);
+	particles.exportState(frame.particles);
+}
 
+/*  Minimap image for the render thread  */
 
-		//set sfml sprite's angle from body's angle
-		it->setRot(it->getB2Body()->GetAngle()*RADTODEG);
+std::shared_ptr<const MinimapImage> World::getMinimap() {
+	std::shared_ptr<const MinimapImage> image = minimap.getImage(stats.ticks);
+	stats.minimap_images = minimap.getImageCount();
+	return image;
+}
 
+/*  Count units and ground in the minimap  */
 
-		it->drawTo(window);
+void World::rebuild_minimap() {
+	minimap.reset(sf::Vector2f(level_width, Game::HEIGHT));
+	for (const TerrainPiece& piece : terrain_pieces) {
+		if (piece.entity->getTypeId() == Game::TYPE_ID::ground) {
+			minimap.addGround(sf::FloatRect(piece.rect.left, piece.rect.top, piece.rect.width, piece.rect.height));
+		}
+	}
+	for (const auto& it : objects) {
+		it->setMinimapCell(minimap.insert(it->getTeamId(), it->getPosition()));
 	}
+	for (const auto& it : player_planes) {
+		it->setMinimapCell(minimap.insert(it->getTeamId(), it->getPosition()));
+	}
+}
 
-	// update the score
-	updateScore(game_mode);
+/*  Make new version of the scenery  */
 
-	return checkGameStatus(game_mode);
+void World::update_scenery() {
+	auto next = std::make_shared<Scenery>();
+	next->level = scenery_level;
+	next->version = (scenery && scenery->level == scenery_level) ? scenery->version + 1 : 0;
+	next->size = sf::Vector2f(level_width, Game::HEIGHT);
+	for (const auto& it : objects) {
+		if (Units::get(it->getType())->scenery) {
+			next->sprites.push_back(it->getSpriteState());
+		}
+	}
+	next->dirty.swap(scenery_dirty);
+	// render thread may still draw the previous version, it is released with its last frame
+	scenery = std::move(next);
+	scenery_changed = false;
 }
 
 std::vector<std::shared_ptr<Entity>>& World::get_all_entities()
@@ -622,17 +569,12 @@ GameResult World::checkGameStatus(Game::GameMode game_mode)
 		if (player_planes.empty()) {
 			return GameResult::RedWon;
 		}
-		
-			// Blue team won if all red planes and bases destroyed
-			for (const auto& it : objects){
-				if ((it->getType() == Textures::RedBase_alpha )|| (it->getType() == Textures::RedAirplane_alpha)) {
-					// not all red planes and bases destroyed, game UnFinished
-					return GameResult::UnFinished;
-				}
-			}
-			// All red planes and bases destroyed
-			return GameResult::BlueWon;
-		
+		// Blue team won if all red planes and bases destroyed
+		if (counters.count(Game::TEAM_ID::red, Game::TYPE_ID::base) > 0
+		    || counters.count(Game::TEAM_ID::red, Game::TYPE_ID::airplane) > 0) {
+			return GameResult::UnFinished;
+		}
+		return GameResult::BlueWon;
 	}
 	else {
 		// Multiplayer is over when red or blue plane is destroyed
@@ -641,12 +583,9 @@ GameResult World::checkGameStatus(Game::GameMode game_mode)
 				if (player_planes[0]->getType() == Textures::RedAirplane_alpha) {
 					return GameResult::RedWon;
 				}
-				 {return GameResult::BlueWon;
-}
+				return GameResult::BlueWon;
 			}
-			else { return GameResult::TieGame;
-}
-
+			return GameResult::TieGame;
 		}
 		// both planes still active
 		return GameResult::UnFinished;
@@ -660,34 +599,309 @@ int World::getScore()
 
 Entity* World::findEntity(b2Body *body)
 {
-	for (auto & object : objects) {
-		if (object->getB2Body() == body) {
-			return object.get();
-		}
-		
-			std::list<std::shared_ptr<Entity>>& entitys_bullets = object->get_active_bullets();
-			for (auto & entitys_bullet : entitys_bullets) {
-				if (entitys_bullet->getB2Body() == body) {
-					return entitys_bullet.get();
-				}
+	// every entity body points to its entity, removed entities reset the pointer
+	return static_cast<Entity*>(body->GetUserData());
+}
+
+Entity* World::findEntity(b2Fixture *fixture)
+{
+	if (fixture->GetUserData() != nullptr) {
+		// merged terrain, the terrain body has no entity
+		return static_cast<TerrainFixture*>(fixture->GetUserData())->entity;
+	}
+	return findEntity(fixture->GetBody());
+}
+
+const WorldStats& World::getStats() const
+{
+	return stats;
+}
+
+/*  Connect entity to the world systems  */
+
+void World::attach_entity(Entity *entity)
+{
+	entity->setProjectileSystem(&projectiles);
+	entity->setParticleSystem(&particles);
+	entity->setCooldown(&cooldowns, cooldowns.acquire());
+	counters.add(entity->getTeamId(), entity->getTypeId());
+	if (entity->getTypeId() == Game::TYPE_ID::hangar) {
+		hangars.push_back(entity);
+	}
+}
+
+/*  Pre-create hangar reinforcements  */
+
+void World::prewarm_reinforcements()
+{
+	reinforcement_targets = counters;
+	std::size_t pooled = 0;
+	for (Entity* hangar : hangars) {
+		Game::TEAM_ID team = hangar->getTeamId();
+		for (Game::TYPE_ID type : {Game::TYPE_ID::airplane, Game::TYPE_ID::infantry}) {
+			Textures::ID id = UnitTexture(team, type);
+			int count = type == Game::TYPE_ID::airplane ? Hangar::POOLED_PLANES : Hangar::POOLED_INFANTRY;
+			for (int i = 0; i < count; i++) {
+				reinforcement_pools[id].push_back(create_pooled_unit(id, hangar->getPosition()));
+				pooled++;
+			}
+		}
+	}
+	// spawning doesn't grow the containers
+	objects.reserve(objects.size() + pooled);
+	stats.pooled_units = pooled;
+}
+
+std::shared_ptr<Entity> World::create_pooled_unit(Textures::ID id, const sf::Vector2f& position) {
+	const Units::Prototype& prototype = *Units::get(id);
+	sf::Vector2u size = resources.get(id).getSize();
+	b2Body* body = pworld.create_body(prototype, position.x, position.y, size.x, size.y);
+	body->SetActive(false);
+	std::shared_ptr<Entity> entity = instantiate(id, body, position);
+	body->SetUserData(entity.get());
+	if (prototype.team == Game::TEAM_ID::red) {
+		// red team comes from the right
+		entity->setDirection({-1.f,0});
+		entity->faceLeft();
+	}
+	return entity;
+}
+
+/*  Hangars send reinforcements  */
+
+void World::update_hangars()
+{
+	for (Entity* hangar : hangars) {
+		if (! cooldowns.ready(hangar->getCooldown())) {
+			continue;
+		}
+		Game::TEAM_ID team = hangar->getTeamId();
+		for (Game::TYPE_ID type : {Game::TYPE_ID::airplane, Game::TYPE_ID::infantry}) {
+			if (counters.count(team, type) < reinforcement_targets.count(team, type) && spawn_reinforcement(*hangar, type)) {
+				cooldowns.start(hangar->getCooldown(), Cooldowns::toTicks(Hangar::REINFORCEMENT_INTERVAL));
+				break;
+			}
+		}
+	}
+}
+
+bool World::spawn_reinforcement(Entity& hangar, Game::TYPE_ID type)
+{
+	auto start = std::chrono::steady_clock::now();
+	auto pool = reinforcement_pools.find(UnitTexture(hangar.getTeamId(), type));
+	if (pool == reinforcement_pools.end() || pool->second.empty()) {
+		return false;
+	}
+	std::shared_ptr<Entity> unit = std::move(pool->second.back());
+	pool->second.pop_back();
+
+	// planes start above the hangar, infantry walks out of the door
+	sf::Vector2f position = hangar.getPosition();
+	sf::Vector2u hangar_size = hangar.getSize();
+	sf::Vector2u unit_size = unit->getSize();
+	if (type == Game::TYPE_ID::airplane) {
+		position.y -= hangar_size.y / 2.f + unit_size.y;
+	}
+	else {
+		float side = hangar.getTeamId() == Game::TEAM_ID::red ? -1.f : 1.f;
+		position.x += side * (hangar_size.x / 2.f + unit_size.x);
+		position.y += (hangar_size.y / 2.f) - (unit_size.y / 2.f);
+	}
+	b2Body* body = unit->getB2Body();
+	body->SetTransform(b2Vec2(position.x*Game::TOMETERS, position.y*Game::TOMETERS), 0);
+	body->SetActive(true);
+	unit->setPos(position);
+	unit->storePreviousTransform();
+	attach_entity(unit.get());
+	unit->setMinimapCell(minimap.insert(unit->getTeamId(), position));
+	chunks.insert(unit.get());
+	objects.push_back(std::move(unit));
+
+	double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	stats.reinforcements++;
+	stats.spawn_micros_total += micros;
+	stats.spawn_micros_peak = std::max(stats.spawn_micros_peak, micros);
+	stats.pooled_units--;
+	return true;
+}
+
+/*  Damage entities hit by projectiles  */
+
+void World::apply_projectile_hits()
+{
+	for (const ProjectileHit& hit : projectile_hits) {
+		const Weapons::ProjectileSpec& spec = Weapons::Projectiles[hit.weapon];
+		if (spec.blast_radius > 0) {
+			// resolved together after all hits
+			detonations.push_back({hit.point, spec.blast_radius * Game::TOMETERS, hit.damage, hit.owner});
+			continue;
+		}
+		Entity* target = findEntity(hit.fixture);
+		if (target != nullptr) {
+			damage_entity(target, hit.damage, hit.owner);
+		}
+	}
+	resolve_detonations();
+}
+
+/*  Splash damage of the bombs that exploded during the step  */
+
+void World::resolve_detonations()
+{
+	for (const Detonation& blast : detonations) {
+		particles.emit(ParticleSystem::bomb_blast, sf::Vector2f(blast.center.x, blast.center.y) * Game::TOPIXELS);
+		blast_fixtures.clear();
+		projectiles.queryBlast(blast.center, blast.radius, blast_fixtures);
+		blast_targets.clear();
+		for (b2Fixture* fixture : blast_fixtures) {
+			if (fixture->GetBody() == terrain_body) {
+				// blasts don't dig the terrain
+				continue;
+			}
+			Entity* target = findEntity(fixture);
+			if (target != nullptr && target != blast.owner) {
+				blast_targets.push_back(target);
 			}
-		
-	}
-	// Go through player_planes
-	for (auto & player_plane : player_planes) {
-		if (player_plane->getB2Body() == body) {
-			return player_plane.get();
-		}
-		
-			std::list<std::shared_ptr<Entity>>& entitys_bullets = player_plane->get_active_bullets();
-			for (auto & entitys_bullet : entitys_bullets) {
-				if (entitys_bullet->getB2Body() == body) {
-					return entitys_bullet.get();
+		}
+		// each entity is damaged once per blast
+		std::sort(blast_targets.begin(), blast_targets.end());
+		blast_targets.erase(std::unique(blast_targets.begin(), blast_targets.end()), blast_targets.end());
+		for (Entity* target : blast_targets) {
+			damage_entity(target, blast.damage, blast.owner);
+		}
+	}
+	stats.detonations += detonations.size();
+	detonations.clear();
+}
+
+/*  Damage entity, destroy and credit the kill if it dies  */
+
+void World::damage_entity(Entity *target, int amount, Entity *attacker)
+{
+	if (target->damage(amount)) {
+		// the type tag tells the attacker is a Plane
+		if (attacker != nullptr && attacker->getTypeId() == Game::TYPE_ID::airplane) {
+			static_cast<Plane*>(attacker)->addToKillList(target);
+		}
+		destroyed_entity_bodies.push_back(target->getB2Body());
+	}
+}
+
+/*  Merge ground and wall boxes to the terrain body  */
+
+void World::compile_terrain()
+{
+	if (terrain_body != nullptr) {
+		pworld.remove_body(terrain_body);
+		terrain_body = nullptr;
+	}
+	terrain_fixtures.clear();
+	stats.terrain_boxes = terrain_pieces.size();
+	stats.terrain_proxies = 0;
+	if (terrain_pieces.empty()) {
+		return;
+	}
+	terrain_body = pworld.create_body_terrain();
+
+	// ground and walls collide differently, so they are merged separately
+	for (Game::TYPE_ID kind : {Game::TYPE_ID::ground, Game::TYPE_ID::invisible_wall}) {
+		std::vector<TerrainRect> rects;
+		std::vector<Entity*> sources;
+		for (const auto& piece : terrain_pieces) {
+			if (piece.entity->getTypeId() == kind) {
+				rects.push_back(piece.rect);
+				sources.push_back(piece.entity);
+			}
+		}
+		for (const TerrainGroup& group : Terrain::merge(rects)) {
+			// a loop has one proxy per edge and is hollow, so bodies inside it
+			// aren't pushed out. Only outlines with fewer edges than boxes pay off.
+			if (Terrain::countEdges(group.loops) < group.rects.size()) {
+				TerrainFixture terrain_fixture;
+				for (std::size_t index : group.rects) {
+					terrain_fixture.sources.push_back(sources[index]);
+				}
+				// contacts are resolved with the first box of the group
+				terrain_fixture.entity = terrain_fixture.sources.front();
+				terrain_fixtures.push_back(std::move(terrain_fixture));
+				for (const TerrainLoop& loop : group.loops) {
+					b2Fixture* fixture = pworld.add_terrain_loop(terrain_body, loop);
+					fixture->SetUserData(&terrain_fixtures.back());
+					stats.terrain_proxies += fixture->GetShape()->GetChildCount();
 				}
+				continue;
 			}
-		
+			for (std::size_t index : group.rects) {
+				terrain_fixtures.push_back({sources[index], {sources[index]}});
+				b2Fixture* fixture = pworld.add_terrain_box(terrain_body, rects[index]);
+				fixture->SetUserData(&terrain_fixtures.back());
+				stats.terrain_proxies += fixture->GetShape()->GetChildCount();
+			}
+		}
 	}
-	return nullptr;
+}
+
+/*  Rest static guns on the ground  */
+
+void World::settle_on_ground()
+{
+	for (const auto& it : objects) {
+		if (it->getTypeId() != Game::TYPE_ID::antiaircraft) {
+			continue;
+		}
+		b2Body* body = it->getB2Body();
+		b2Fixture* fixture = body->GetFixtureList();
+		while (fixture != nullptr && fixture->IsSensor()) {
+			fixture = fixture->GetNext();
+		}
+		if (fixture == nullptr) {
+			continue;
+		}
+		b2AABB box;
+		fixture->GetShape()->ComputeAABB(&box, body->GetTransform(), 0);
+
+		// y grows downwards, the highest ground top below the top of the gun wins
+		bool found = false;
+		float ground_top = 0.f;
+		for (const auto& piece : terrain_pieces) {
+			if (piece.entity->getTypeId() != Game::TYPE_ID::ground) {
+				continue;
+			}
+			float left = piece.rect.left * Game::TOMETERS;
+			float right = (piece.rect.left + piece.rect.width) * Game::TOMETERS;
+			float top = piece.rect.top * Game::TOMETERS;
+			if (right <= box.lowerBound.x || left >= box.upperBound.x || top < box.lowerBound.y) {
+				continue;
+			}
+			if (! found || top < ground_top) {
+				ground_top = top;
+				found = true;
+			}
+		}
+		if (! found) {
+			continue;
+		}
+		b2Vec2 position = body->GetPosition() + b2Vec2(0.f, ground_top - box.upperBound.y);
+		body->SetTransform(position, body->GetAngle());
+		it->setPos(sf::Vector2f(Game::TOPIXELS * position.x, Game::TOPIXELS * position.y));
+		it->storePreviousTransform();
+	}
+}
+
+bool World::remove_terrain_piece(Entity *entity)
+{
+	auto it = std::find_if(terrain_pieces.begin(), terrain_pieces.end(),
+	                       [entity](const TerrainPiece& piece) { return piece.entity == entity; });
+	if (it == terrain_pieces.end()) {
+		return false;
+	}
+	terrain_pieces.erase(it);
+	return true;
+}
+
+float World::getLevelWidth()
+{
+	return level_width;
 }
 
 void World::updateScore(Game::GameMode game_mode)
@@ -696,7 +910,8 @@ void World::updateScore(Game::GameMode game_mode)
 	score = 0;
 	if (game_mode == Game::GameMode::SinglePlayer) {
 		if (!player_planes.empty()) {
-			auto* plane = dynamic_cast<Plane*> (player_planes[0].get());
+			// player plane is always a Plane, its kill total is kept up to date
+			auto* plane = static_cast<Plane*>(player_planes[0].get());
 			score = plane->getGrandTotalKill() * 1000;
 		}
 		else {
@@ -14,7 +14,6 @@
 #include "Plane.hpp"
 #include "Artillery.hpp"
 #include "Infantry.hpp"
-#include "Bullet.hpp"
 #include "Tree.hpp"
 #include "Stone.hpp"
 #include "Base.hpp"
@@ -22,16 +21,29 @@
 #include "Hangar.hpp"
 #include "AI.hpp"
 #include "InvisibleWall.hpp"
+#include "LevelParser.hpp"
+#include "ChunkGrid.hpp"
+#include "WorldSnapshot.hpp"
+#include "WorldStats.hpp"
+#include "TerrainOutline.hpp"
+#include "ProjectileSystem.hpp"
+#include "ParticleSystem.hpp"
+#include "Minimap.hpp"
+#include "Cooldowns.hpp"
+#include "CollisionResponse.hpp"
+#include "EntityCounters.hpp"
+#include "RenderFrame.hpp"
 
 #include <iostream>
 #include <SFML/Graphics.hpp>
 #include <algorithm>
 #include <vector>
 #include <Box2D/Box2D.h>
-#include <fstream>
-#include <sstream>
 #include <list>
 #include <deque>
+#include <unordered_map>
+#include <map>
+#include <memory_resource>
 
 
 #define DEGTORAD 0.0174532925199432957f
@@ -69,29 +81,21 @@ public:
 
 	/**
       *   @brief Adds given entity to the game
+      *   @details Body and entity are created from the unit prototype of id
       *   @param id: string of entity's type
       *   @param x: x-axis coordinate
       *   @param y: y-axis coordinate
       *   @param orientation: direction where the entity is facing
       *   @param width: width of the entity
       *   @param height: height of the entity
-      *   @param direct: direction where entity is headed
       *   @param game_mode: single- or multiplayer
       *   @return Returns true if succesful, false if not
       */
-	bool create_entity(Textures::ID id, double x, double y, int orientation, double width, double height, sf::Vector2f direct, Game::GameMode game_mode);
-
-  /**
-      *   @brief Removes given bullet from the game
-      *   @param bullet Raw pointer to the bullet entity that is being removed
-      *   @param entity If this matches to the owner of the Bullet, Bullet isn't removed (this is a leftover from legacy implementation)
-      *   @return Returns true if succesful, false if not
-      */
-  bool remove_bullet(Entity *bullet, Entity *entity);
+	bool create_entity(Textures::ID id, double x, double y, int orientation, double width, double height, Game::GameMode game_mode);
 
   /**
       *   @brief Remove entity
-      *   @remark Don't use this to remove Bullets
+      *   @details Projectiles of the entity are removed too
       *   @param entity Entity to be removed
       */
 
@@ -99,26 +103,68 @@ public:
 
 	/**
       *   @brief Updates the world
-      *   @details Is called from the game engine
+      *   @details Is called from the game engine once per simulation step,
+      *   nothing is drawn
       *   @param game_mode Current Game::GameMode
       *   @return Returns GameResult
       */
 	GameResult update(Game::GameMode game_mode);
 
+	/**
+      *   @brief Copy entities near the players and the projectiles to a frame
+      *   @details Is called from the game engine after the steps of a frame,
+      *   the frame is drawn by the render thread. Scenery is shared with the
+      *   previous frame unless a static entity was destroyed. Only the chunks
+      *   overlapping the visible area are published.
+      *   @param frame Frame to be appended to
+      *   @param visible Area the camera shows during the frame (pixels)
+      */
+	void publish(RenderFrame& frame, const sf::FloatRect& visible);
+
+	/**
+      *   @brief Get units of the whole level by team
+      *   @details The image is made again at most every
+      *   Minimap::IMAGE_INTERVAL steps, in between the same image is returned
+      *   @return Returns the minimap image
+      */
+	std::shared_ptr<const MinimapImage> getMinimap();
+
 	/**
       *   @brief Reads the given level
       *   @details Is called from the game engine
       *   @param filename Filename of level to be opened
       *   @param game_mode Is the game multiplayer or singleplayer
+      *   @return Returns false if the file couldn't be read or a line was malformed
       */
         bool read_level(std::string& filename, Game::GameMode game_mode);
 
 	/**
       *   @brief Clears all entitys
-      *   @details Is called from the game engine when new game is started
+      *   @details Is called from the game engine when new game is started.
+      *   The Box2D world is recreated and the entity arena released, bodies
+      *   aren't destroyed one by one.
       */
         void clear_all();
 
+	/**
+      *   @brief Store the current world to snapshot
+      *   @details Call right after read_level to be able to restart the level
+      *   with restore_snapshot
+      *   @param snapshot Snapshot to be overwritten
+      *   @param filename Level file name the world was read from
+      *   @param game_mode Game mode used with read_level
+      */
+        void take_snapshot(WorldSnapshot& snapshot, const std::string& filename, Game::GameMode game_mode);
+
+	/**
+      *   @brief Replace the world with the snapshot content
+      *   @details Recreates bodies, fixtures and entities in one pass without
+      *   file I/O or parsing
+      *   @param snapshot Snapshot created with take_snapshot
+      *   @return Returns false if snapshot is empty
+      */
+        bool restore_snapshot(const WorldSnapshot& snapshot);
+
 	/**
       *   @return Returns all objects
       */
@@ -144,10 +190,31 @@ public:
           */
         Entity* findEntity(b2Body *body);
 
+        /**
+          *   @brief Find Entity of a fixture
+          *   @details Fixtures of the merged terrain body map to the ground or
+          *   wall entity they were built from
+          *   @param fixture Box2D fixture
+          *   @return Returns raw pointer to the entity
+          */
+        Entity* findEntity(b2Fixture *fixture);
+
+        /**
+          *   @return Returns physics counters of the last update
+          */
+        const WorldStats& getStats() const;
+
+        /**
+          *   @brief Get level width
+          *   @return Returns the right most point of the level (at least Game::WIDTH)
+          */
+        float getLevelWidth();
+
 private:
 
   /**
     *   @brief Check game status
+    *   @details Uses the entity counters, doesn't scan the entities
     *   @return Returns correct GameResult
     *   @param game_mode Current Game::GameMode
     */
@@ -159,12 +226,174 @@ private:
     */
   void updateScore(Game::GameMode game_mode);
 
+  /**
+    *   @brief Construct entity with the factory of its unit prototype
+    *   @param id Texture id of the entity, must have a prototype
+    *   @param body Already created body
+    *   @param pos Sprite position
+    *   @return Returns created entity, user data of the body is not set
+    */
+  std::shared_ptr<Entity> instantiate(Textures::ID id, b2Body* body, const sf::Vector2f& pos);
+
+  /**
+    *   @brief Connect a new entity to the projectile system and cooldowns
+    *   @details The entity is also added to the counters
+    *   @param entity Entity that was just created
+    */
+  void attach_entity(Entity *entity);
+
+  /**
+    *   @brief Pre-create reinforcements of the hangars
+    *   @details Every hangar adds Hangar::POOLED_PLANES planes and
+    *   Hangar::POOLED_INFANTRY infantry of its team to the pools. Bodies and
+    *   fixtures are created now and deactivated, so spawning allocates
+    *   nothing. The current counters become the reinforcement targets.
+    */
+  void prewarm_reinforcements();
+
+  /**
+    *   @brief Create deactivated unit for the reinforcement pool
+    *   @param id Texture id of the unit
+    *   @param position Sprite position
+    *   @return Returns the unit, it isn't in the world containers
+    */
+  std::shared_ptr<Entity> create_pooled_unit(Textures::ID id, const sf::Vector2f& position);
+
+  /**
+    *   @brief Let hangars replace lost planes and infantry
+    *   @details A hangar whose cooldown is over spawns a unit of a type its
+    *   team has fewer of than at the start of the level
+    */
+  void update_hangars();
+
+  /**
+    *   @brief Move a pooled unit next to the hangar and activate it
+    *   @param hangar Spawning hangar
+    *   @param type Game::TYPE_ID::airplane or Game::TYPE_ID::infantry
+    *   @return Returns false if the pool is empty
+    */
+  bool spawn_reinforcement(Entity& hangar, Game::TYPE_ID type);
+
+  /**
+    *   @brief Apply damage of the projectile hits of the last step
+    *   @details Bomb hits are gathered to detonations and resolved after
+    *   the direct hits
+    */
+  void apply_projectile_hits();
+
+  /**
+    *   @brief Apply splash damage of the gathered detonations
+    *   @details One broadphase query per detonation, entities are damaged
+    *   once per blast. The bomber itself and the terrain aren't damaged.
+    */
+  void resolve_detonations();
+
+  /**
+    *   @brief Damage entity and queue it for removal if it dies
+    *   @param target Damaged entity
+    *   @param amount Damage
+    *   @param attacker Entity credited for the kill, may be nullptr
+    */
+  void damage_entity(Entity *target, int amount, Entity *attacker);
+
+  /**
+    *   @struct Detonation
+    *   @brief Bomb that exploded during the step
+    */
+  struct Detonation {
+    b2Vec2 center; /**< Impact point in meters */
+    float radius; /**< Blast radius in meters */
+    int damage;
+    Entity* owner; /**< Bomber */
+  };
+
+  /**
+    *   @brief Make a new scenery version of the static entities
+    *   @details Called by publish when scenery_changed is set
+    */
+  void update_scenery();
+
+  /**
+    *   @brief Count all units and ground of the level in the minimap
+    *   @details Called when a level is loaded or the terrain changes, in
+    *   between units are moved in the grid by update
+    */
+  void rebuild_minimap();
+
+  /**
+    *   @brief Build the terrain body from terrain_pieces
+    *   @details All boxes go to one static body. Connected ground boxes (and
+    *   wall boxes) are merged to chain loops when the outline has fewer edges
+    *   than the group has boxes, so internal edges create no proxies or
+    *   contacts. Other groups keep their solid boxes. The previous terrain
+    *   body is destroyed.
+    */
+  void compile_terrain();
+
+  /**
+    *   @brief Put anti aircraft guns on the ground below them
+    *   @details Guns have static bodies and don't fall, a gun placed above
+    *   the ground in the level file would float and one placed into it would
+    *   stay inside. Each gun is moved so its box rests on the highest ground
+    *   box under it whose top is below the top of the gun, like a dynamic
+    *   body pushed out of the ground. Guns without ground under them stay.
+    */
+  void settle_on_ground();
+
+  /**
+    *   @brief Remove terrain piece of the entity
+    *   @param entity Ground or wall entity
+    *   @return Returns true if the entity had a piece, terrain must be recompiled
+    */
+  bool remove_terrain_piece(Entity *entity);
+
+  /**
+    *   @struct TerrainPiece
+    *   @brief Ground or wall box of the level
+    */
+  struct TerrainPiece {
+    TerrainRect rect; /**< Box in pixels */
+    Entity* entity; /**< Entity with the anchor body */
+  };
+
+  /**
+    *   @struct TerrainFixture
+    *   @brief User data of the terrain body fixtures
+    */
+  struct TerrainFixture {
+    Entity* entity; /**< Entity used in contacts */
+    std::vector<Entity*> sources; /**< Entities whose boxes were merged to the fixture */
+  };
+
   PhysicsWorld pworld;
   ResourceManager &resources;
   sf::RenderWindow &window; /**< Window that is being used */
+  std::pmr::unsynchronized_pool_resource entity_arena; /**< Memory of all entities. Memory of removed entities is reused by the next entity of the same size, so a match needs at most its peak of live entities. clear_all releases it all at once. Declared before the containers, so it outlives them */
   std::vector<std::shared_ptr<Entity>> objects; /**< Contains all the entities added */
   std::deque<std::shared_ptr<Entity>> player_planes; /**< Contains BlueAirplane and during multiplayer also one RedAirplane */
   std::list<b2Body*> destroyed_entity_bodies; /**< Destroyed entity bodies which should be removed from the world */
-  std::list<b2Body*> destroyed_bullet_bodies; /**< Destroyed bullet bodies which should be removed from the world */
+  ChunkGrid chunks; /**< Entities of objects by x-coordinate, only chunks near player planes are active */
+  float level_width = Game::WIDTH; /**< Right most point of the level */
+  std::vector<TerrainPiece> terrain_pieces; /**< Ground and wall boxes merged to terrain_body */
+  std::deque<TerrainFixture> terrain_fixtures; /**< Fixture user data, deque keeps the pointers valid */
+  b2Body* terrain_body = nullptr; /**< Static body with the merged terrain fixtures */
+  ProjectileSystem projectiles; /**< Bullets of all entities */
+  ParticleSystem particles; /**< Explosions and muzzle flashes */
+  Minimap minimap; /**< Units of the whole level by team */
+  std::vector<ProjectileHit> projectile_hits; /**< Hits of the last step, reused */
+  std::vector<Detonation> detonations; /**< Bomb hits of the step */
+  std::vector<b2Fixture*> blast_fixtures; /**< Query results, reused */
+  std::vector<Entity*> blast_targets; /**< Entities of one blast, reused */
+  Cooldowns cooldowns; /**< Fire rate timers of all entities, advanced once per update */
+  EntityCounters counters; /**< Live entities per team and type */
+  EntityCounters reinforcement_targets; /**< Counters at the start of the level */
+  std::vector<Entity*> hangars; /**< Hangars of objects */
+  std::map<Textures::ID, std::vector<std::shared_ptr<Entity>>> reinforcement_pools; /**< Deactivated units by texture id */
+  std::shared_ptr<const Scenery> scenery; /**< Static entities of the last publish, shared with the render thread */
+  std::vector<Entity*> visible_entities; /**< Chunk query result of publish, reused */
+  std::vector<sf::FloatRect> scenery_dirty; /**< Regions of scenery destroyed since the last publish */
+  bool scenery_changed = true; /**< Scenery must be made again before the next publish */
+  long scenery_level = 0; /**< Increased by clear_all */
+  WorldStats stats;
   int score = 0;
 };
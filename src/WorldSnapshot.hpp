@@ -0,0 +1,74 @@
+/**
+  *   @file WorldSnapshot.hpp
+  *   @brief Structs used to store a fully built World in memory
+  */
+
+#pragma once
+
+/*  Includes  */
+
+#include "CommonDefinitions.hpp"
+#include "Entity.hpp"
+#include "TerrainOutline.hpp"
+#include <Box2D/Box2D.h>
+#include <string>
+#include <vector>
+
+/**
+  *   @struct FixtureSnapshot
+  *   @brief Copy of a fixture definition
+  */
+struct FixtureSnapshot
+{
+  b2Shape::Type shape_type; /**< Tells which one of the shapes is used */
+  b2PolygonShape polygon; /**< Used with b2Shape::e_polygon */
+  b2CircleShape circle; /**< Used with b2Shape::e_circle */
+  float density;
+  float friction;
+  float restitution;
+  bool sensor;
+  b2Filter filter;
+};
+
+/**
+  *   @struct EntitySnapshot
+  *   @brief Everything needed to recreate one Entity and its body
+  */
+struct EntitySnapshot
+{
+  Textures::ID type; /**< Texture id of the entity, tells also the entity class */
+  bool player_plane; /**< Entity belongs to World player_planes */
+  b2BodyDef body; /**< Body state (position, velocity, flags) */
+  std::vector<FixtureSnapshot> fixtures;
+  Entity::State state; /**< Sprite and game state of the entity */
+};
+
+/**
+  *   @struct TerrainSnapshot
+  *   @brief Ground or wall box merged to the terrain body
+  */
+struct TerrainSnapshot
+{
+  TerrainRect rect; /**< Box in pixels */
+  std::size_t entity; /**< Index of the owning entity in WorldSnapshot entities */
+};
+
+/**
+  *   @struct WorldSnapshot
+  *   @brief In-memory copy of a World right after the level was read
+  *   @details World::restore_snapshot rebuilds the World from this without
+  *   file I/O or parsing
+  */
+struct WorldSnapshot
+{
+  std::string level_file; /**< Level file the snapshot was taken from */
+  Game::GameMode game_mode = Game::GameMode::SinglePlayer; /**< Game mode used when the level was read */
+  float level_width = 0; /**< World level width */
+  std::vector<EntitySnapshot> entities; /**< Player planes first, then objects in order */
+  std::vector<TerrainSnapshot> terrain; /**< Terrain body is recompiled from these */
+
+  /**
+    *   @return Returns true if the snapshot contains a world
+    */
+  bool valid() const { return ! entities.empty(); }
+};
@@ -0,0 +1,44 @@
+/**
+  *   @file WorldStats.hpp
+  *   @brief Struct for World profiling counters
+  */
+
+#pragma once
+
+/**
+  *   @struct WorldStats
+  *   @brief Physics counters updated by World every tick
+  *   @details Shown in the game info overlay (F3)
+  */
+struct WorldStats
+{
+  int bodies = 0; /**< Box2D bodies */
+  int active_bodies = 0; /**< Bodies in the step, bodies of inactive chunks are left out */
+  int entities = 0; /**< Entities of the level, player planes included */
+  int active_entities = 0; /**< Entities updated in the tick, player planes included */
+  int proxies = 0; /**< Broadphase proxies (one per fixture child) */
+  int contacts = 0; /**< Contacts created by the broadphase */
+  int touching_contacts = 0; /**< Contacts whose fixtures touch */
+  int terrain_boxes = 0; /**< Ground and wall boxes of the level, one proxy each before merging */
+  int terrain_proxies = 0; /**< Proxies of the merged terrain body */
+  int live_bullets = 0; /**< Projectiles in flight after the step */
+  int pooled_units = 0; /**< Hangar reinforcements waiting in the pools */
+  int live_particles = 0; /**< Explosion and muzzle flash particles after the step */
+  int visible_entities = 0; /**< Entities of the last publish near the camera */
+  int culled_entities = 0; /**< Active entities of the last publish skipped outside the camera */
+
+  /*  Totals since the level was loaded  */
+  long ticks = 0; /**< Updates since the level was loaded */
+  long total_contacts = 0; /**< Sum of contacts over all ticks */
+  int peak_contacts = 0; /**< Most contacts in one tick */
+  long total_active_entities = 0; /**< Sum of active_entities over all ticks */
+  long total_active_bodies = 0; /**< Sum of active_bodies over all ticks */
+  long bullets_expired = 0; /**< Bullets retired by lifetime */
+  long bullets_out_of_bounds = 0; /**< Bullets retired after leaving the level */
+  long detonations = 0; /**< Bombs exploded */
+  long particles_dropped = 0; /**< Particles not emitted because of the step budget or the pool capacity */
+  long reinforcements = 0; /**< Units spawned by hangars */
+  long minimap_images = 0; /**< Minimap images made for the render thread */
+  double spawn_micros_total = 0; /**< Time spent spawning reinforcements (microseconds) */
+  double spawn_micros_peak = 0; /**< Slowest spawn (microseconds) */
+};
@@ -14,8 +14,11 @@
 #include "CommonDefinitions.hpp"
 #include "GameEngine.hpp"
 #include "Stats.hpp"
+#include "FrameRecorder.hpp"
+#include "AssetCache.hpp"
 #include <memory>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <ctime>
 #include <SFML/Audio/Music.hpp>
@@ -33,15 +36,109 @@ void setWindowPosition(sf::RenderWindow &window)
 }
 
 
+/**
+  *   @brief Apply the --render-scale option
+  *   @details --render-scale <percent> draws the level at a fixed share of
+  *   the window resolution (50...100). Without the option the scale starts
+  *   at native resolution and is lowered when drawing can't keep 60 fps.
+  *   @param game Game engine whose render thread draws the level
+  *   @param argc Argument count
+  *   @param argv Arguments
+  */
+void setRenderScale(GameEngine &game, int argc, char* argv[])
+{
+  for (int i = 1; i + 1 < argc; i++)
+  {
+    if (std::strcmp(argv[i], "--render-scale") == 0)
+    {
+      game.setRenderScale(std::atoi(argv[i + 1]) / 100.f, false);
+      return;
+    }
+  }
+  game.setRenderScale(1.f, true);
+}
+
+/**
+  *   @brief Record a single player level without the menus
+  *   @details Options: --record directory [--yuv] [--headless] [--steps n]
+  *   [--level file]. Headless recording needs an OpenGL context but no
+  *   visible window, e.g. xvfb-run with LIBGL_ALWAYS_SOFTWARE=1.
+  *   @param argc Argument count
+  *   @param argv Arguments
+  *   @return Returns exit code
+  */
+int record(int argc, char* argv[])
+{
+  std::string directory;
+  std::string level_name = "../data/level_files/Testi.txt";
+  FrameRecorder::Format format = FrameRecorder::png_sequence;
+  bool headless = false;
+  long steps = 0;
+  for (int i = 1; i < argc; i++)
+  {
+    bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--record") == 0 && has_value)
+    {
+      directory = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--level") == 0 && has_value)
+    {
+      level_name = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--steps") == 0 && has_value)
+    {
+      steps = std::atol(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--yuv") == 0)
+    {
+      format = FrameRecorder::yuv_stream;
+    }
+    else if (std::strcmp(argv[i], "--headless") == 0)
+    {
+      headless = true;
+    }
+  }
+
+  sf::RenderWindow window;
+  window.create(sf::VideoMode(Game::WIDTH, Game::HEIGHT), "Air Combat 1 (recording)", sf::Style::Close);
+  if (headless)
+  {
+    window.setVisible(false);
+  }
+  FrameRecorder recorder(directory, format, Game::WIDTH, Game::HEIGHT);
+  if (! recorder.isOpen())
+  {
+    return 1;
+  }
+  GameEngine game {window};
+  setRenderScale(game, argc, argv);
+  game.setGameMode(Game::GameMode::SinglePlayer);
+  game.setRecording(&recorder, headless, steps);
+  game.run(level_name);
+  // Wait for the queued frames
+  recorder.finish();
+  std::cout << "Recorded " << recorder.getEncodedCount() << " frames to " << directory << std::endl;
+  return 0;
+}
+
 /**
   *   @brief Main for Air combat
-  *   @details Integrates MainMenu, LevelEditor and Game
+  *   @details Integrates MainMenu, LevelEditor and Game. With --record
+  *   a level is recorded instead, see record.
   */
-int main()
+int main(int argc, char* argv[])
 {
   // random seed
   std::srand(std::time(nullptr));
 
+  for (int i = 1; i < argc; i++)
+  {
+    if (std::strcmp(argv[i], "--record") == 0)
+    {
+      return record(argc, argv);
+    }
+  }
+
   // Create empty RenderWindows
   sf::RenderWindow window;
   sf::RenderWindow dialog_window;
@@ -53,12 +150,15 @@ int main()
 
   // Create Game Engine
   GameEngine game {window};
+  setRenderScale(game, argc, argv);
 
   // Create objects
   MainMenu menu = MainMenu(window, dialog_window, help_window);
   LevelEditor editor = LevelEditor(window, dialog_window, help_window);
   // Create Stats
   Stats stats = Stats(window);
+  // Game and editor share the textures, each file was decoded once
+  AssetCache::instance().report(std::cout);
 
   int exit_status = ExitStatus::MAINMENU;
 
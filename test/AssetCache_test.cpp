@@ -0,0 +1,58 @@
+/**
+  *   @file AssetCache_test.cpp
+  *   @brief Tests for the shared texture cache
+  */
+
+#include "../src/AssetCache.hpp"
+#include <SFML/Graphics.hpp>
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "AssetCache TEST" << std::endl;
+
+  // Textures are created on this thread, give it a context
+  sf::Context context;
+  AssetCache cache("../data/img/");
+
+  // Nothing is loaded before it is acquired
+  assert(! cache.isLoaded(Textures::Ground_alpha));
+  assert(cache.getDecodedCount() == 0);
+
+  // Second request of a held texture is served from the cache
+  TextureHandle ground = cache.acquire(Textures::Ground_alpha);
+  assert(ground != nullptr);
+  assert(cache.isLoaded(Textures::Ground_alpha));
+  assert(cache.acquire(Textures::Ground_alpha) == ground);
+  assert(cache.getDecodedCount() == 1);
+  assert(cache.getHitCount() == 1);
+
+  // Batch decodes only the missing files, duplicates share one texture
+  std::vector<TextureHandle> batch = cache.acquire({Textures::Tree_alpha, Textures::Rock_alpha,
+                                                    Textures::Tree_alpha, Textures::Ground_alpha});
+  assert(batch.size() == 4);
+  assert(batch[0] == batch[2]);
+  assert(batch[0] != batch[1]);
+  assert(batch[3] == ground);
+  assert(cache.getDecodedCount() == 3);
+  assert(cache.getHitCount() == 2);
+  assert(cache.getSequentialDecodeMs() >= 0.f);
+
+  // Texture is freed with its last handle and decoded again when needed
+  batch.clear();
+  assert(! cache.isLoaded(Textures::Tree_alpha));
+  assert(cache.isLoaded(Textures::Ground_alpha));
+  cache.acquire(Textures::Tree_alpha);
+  assert(cache.getDecodedCount() == 4);
+
+  // Missing files give an empty texture
+  AssetCache missing("AssetCache_test_missing/");
+  TextureHandle empty = missing.acquire(Textures::Ground_alpha);
+  assert(empty != nullptr);
+  assert(empty->getSize() == sf::Vector2u(0, 0));
+
+  cache.report(std::cout);
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
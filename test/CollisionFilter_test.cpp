@@ -0,0 +1,54 @@
+/**
+  *   @file CollisionFilter_test.cpp
+  *   @brief Tests for the collision matrix
+  */
+
+#include "../src/CollisionFilter.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "CollisionFilter TEST" << std::endl;
+  using namespace Collision;
+  const Game::TEAM_ID blue = Game::TEAM_ID::blue;
+  const Game::TEAM_ID red = Game::TEAM_ID::red;
+
+  // Every (kind, team) pair has its own bit
+  assert(getBits(aircraft, blue).category != getBits(aircraft, red).category);
+  assert(getBits(terrain, blue).category == getBits(terrain, red).category);
+  assert(getBits(aircraft, blue).category != getBits(ground_unit, blue).category);
+
+  // Physics pairs
+  assert(collides(getBits(terrain), getBits(aircraft, red)));
+  assert(collides(getBits(terrain), getBits(ground_unit, blue)));
+  assert(collides(getBits(aircraft, blue), getBits(aircraft, red)));
+  assert(collides(getBits(aircraft, blue), getBits(aircraft, blue)));
+
+  // Projectiles hit everything solid
+  for (Kind kind : {terrain, scenery, aircraft, ground_unit, structure, projectile})
+  {
+    assert(collides(getBits(projectile), getBits(kind, blue)));
+    assert(collides(getBits(projectile), getBits(kind, red)));
+  }
+
+  // Sensors see only what the AI uses
+  assert(collides(getBits(radar), getBits(aircraft, blue)));
+  assert(collides(getBits(radar), getBits(scenery)));
+  assert(collides(getBits(radar), getBits(structure, red)));
+  assert(! collides(getBits(radar), getBits(terrain)));
+  assert(! collides(getBits(radar), getBits(projectile)));
+  assert(! collides(getBits(radar), getBits(radar)));
+  assert(collides(getBits(aa_radar, blue), getBits(aircraft, red)));
+  assert(! collides(getBits(aa_radar, blue), getBits(aircraft, blue)));
+  assert(! collides(getBits(aa_radar, red), getBits(ground_unit, blue)));
+  assert(! collides(getBits(aa_radar, red), getBits(scenery)));
+  assert(! collides(getBits(aa_radar, red), getBits(radar)));
+
+  // Static pairs aren't listed
+  assert(! collides(getBits(terrain), getBits(structure, blue)));
+  assert(! collides(getBits(scenery), getBits(terrain)));
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
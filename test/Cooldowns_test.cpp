@@ -0,0 +1,71 @@
+/**
+  *   @file Cooldowns_test.cpp
+  *   @brief Tests for tick based cooldowns
+  */
+
+#include "../src/Cooldowns.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "Cooldowns TEST" << std::endl;
+
+  // Fire intervals of the weapons in ticks
+  assert(Cooldowns::toTicks(0.5f) == 30);
+  assert(Cooldowns::toTicks(1.f) == 60);
+  assert(Cooldowns::toTicks(0.f) == 0);
+
+  // New slot is ready, cooldown lasts exactly the given ticks
+  Cooldowns cooldowns;
+  int gun = cooldowns.acquire();
+  assert(cooldowns.ready(gun));
+  cooldowns.start(gun, 30);
+  cooldowns.advance(29);
+  assert(! cooldowns.ready(gun));
+  cooldowns.advance();
+  assert(cooldowns.ready(gun));
+
+  // Fast-forward, many ticks at once give the same result as single ticks
+  Cooldowns stepped;
+  Cooldowns skipped;
+  int a = stepped.acquire();
+  int b = skipped.acquire();
+  int shots_stepped = 0;
+  for (int tick = 0; tick < 600; tick++)
+  {
+    if (stepped.ready(a))
+    {
+      stepped.start(a, 30);
+      shots_stepped++;
+    }
+    stepped.advance();
+  }
+  int shots_skipped = 0;
+  for (int tick = 0; tick < 600; tick += 30)
+  {
+    assert(skipped.ready(b));
+    skipped.start(b, 30);
+    shots_skipped++;
+    skipped.advance(30);
+  }
+  assert(shots_stepped == 20 && shots_skipped == 20);
+
+  // Released slots are reused and start ready
+  int other = cooldowns.acquire();
+  assert(cooldowns.size() == 2);
+  cooldowns.start(other, 100);
+  cooldowns.release(other);
+  assert(cooldowns.size() == 1);
+  assert(cooldowns.acquire() == other);
+  assert(cooldowns.ready(other));
+  cooldowns.release(-1);
+  assert(cooldowns.size() == 2);
+
+  // Reset frees everything and restarts time
+  cooldowns.reset();
+  assert(cooldowns.size() == 0 && cooldowns.getTick() == 0);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -0,0 +1,36 @@
+/**
+  *   @file EntityCounters_test.cpp
+  *   @brief Tests for live entity counters
+  */
+
+#include "../src/EntityCounters.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "EntityCounters TEST" << std::endl;
+
+  EntityCounters counters;
+  assert(counters.count(Game::TEAM_ID::red) == 0);
+
+  // Red base and two red planes, one blue plane
+  counters.add(Game::TEAM_ID::red, Game::TYPE_ID::base);
+  counters.add(Game::TEAM_ID::red, Game::TYPE_ID::airplane);
+  counters.add(Game::TEAM_ID::red, Game::TYPE_ID::airplane);
+  counters.add(Game::TEAM_ID::blue, Game::TYPE_ID::airplane);
+  assert(counters.count(Game::TEAM_ID::red, Game::TYPE_ID::airplane) == 2);
+  assert(counters.count(Game::TEAM_ID::blue, Game::TYPE_ID::airplane) == 1);
+  assert(counters.count(Game::TEAM_ID::red) == 3);
+
+  counters.remove(Game::TEAM_ID::red, Game::TYPE_ID::airplane);
+  assert(counters.count(Game::TEAM_ID::red, Game::TYPE_ID::airplane) == 1);
+  assert(counters.count(Game::TEAM_ID::red) == 2);
+
+  counters.reset();
+  assert(counters.count(Game::TEAM_ID::red, Game::TYPE_ID::base) == 0);
+  assert(counters.count(Game::TEAM_ID::blue) == 0);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -0,0 +1,77 @@
+/**
+  *   @file FrameRecorder_test.cpp
+  *   @brief Tests for the frame recorder YUV stream
+  */
+
+#include "../src/FrameRecorder.hpp"
+#include <assert.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+int main()
+{
+  std::cout << "FrameRecorder TEST" << std::endl;
+
+  // White is Y 235, black is Y 16, grey has neutral chroma
+  std::vector<sf::Uint8> pixels = {255, 255, 255, 255, 0, 0, 0, 255, 128, 128, 128, 255, 128, 128, 128, 255};
+  std::vector<sf::Uint8> yuv;
+  FrameRecorder::convertToI420(pixels.data(), 2, 2, yuv);
+  assert(yuv.size() == 6);
+  assert(yuv[0] == 235);
+  assert(yuv[1] == 16);
+  assert(yuv[4] == 128 && yuv[5] == 128);
+
+  // Odd sizes round the chroma planes up
+  FrameRecorder::convertToI420(pixels.data(), 1, 3, yuv);
+  assert(yuv.size() == 3 + 2 * 2);
+
+  // Frames are written in submit order although workers encode in parallel
+  const unsigned width = 64;
+  const unsigned height = 48;
+  const std::string directory = "FrameRecorder_test_output";
+  const int frames = 40;
+  long dropped = 0;
+  {
+    FrameRecorder recorder(directory, FrameRecorder::yuv_stream, width, height, 4, 3);
+    assert(recorder.isOpen());
+    std::vector<sf::Uint8> frame(width * height * 4);
+    int submitted = 0;
+    while (submitted < frames)
+    {
+      // Grey level tells the frame number
+      for (std::size_t i = 0; i < frame.size(); i++)
+      {
+        frame[i] = (i % 4 == 3) ? 255 : static_cast<sf::Uint8>(submitted * 5);
+      }
+      if (recorder.submit(frame.data()))
+      {
+        submitted++;
+      }
+      else
+      {
+        // Ring is full, a real capture drops the frame
+        dropped++;
+      }
+    }
+    recorder.finish();
+    assert(recorder.getEncodedCount() == frames);
+    assert(recorder.getDroppedCount() == dropped);
+    assert(! recorder.submit(frame.data()));
+  }
+
+  std::ifstream stream(directory + "/capture.yuv", std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  const std::size_t frame_size = width * height * 3 / 2;
+  assert(data.size() == frame_size * frames);
+  int previous_y = -1;
+  for (int i = 0; i < frames; i++)
+  {
+    int y = static_cast<unsigned char>(data[i * frame_size]);
+    assert(y > previous_y);
+    previous_y = y;
+  }
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -0,0 +1,56 @@
+/**
+  *   @file FrameScheduler_test.cpp
+  *   @brief Tests for fixed step frame scheduling
+  */
+
+#include "../src/FrameScheduler.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "FrameScheduler TEST" << std::endl;
+
+  using std::chrono::milliseconds;
+  const FrameScheduler::Clock::time_point t0;
+  FrameScheduler scheduler(milliseconds(10));
+  scheduler.reset(t0);
+
+  // Nothing is due before one step has passed
+  assert(scheduler.beginFrame(t0 + milliseconds(4)) == 0);
+  assert(scheduler.nextStep() == t0 + milliseconds(10));
+  assert(scheduler.beginFrame(t0 + milliseconds(10)) == 1);
+  scheduler.endFrame(t0 + milliseconds(15));
+
+  // A 25 ms frame runs two steps and keeps the remaining 5 ms
+  assert(scheduler.beginFrame(t0 + milliseconds(35)) == 2);
+  assert(scheduler.nextStep() == t0 + milliseconds(40));
+  scheduler.endFrame(t0 + milliseconds(40));
+
+  // A long stall is capped, the rest of the backlog is dropped
+  assert(scheduler.beginFrame(t0 + milliseconds(1035)) == FrameScheduler::MAX_CATCH_UP_STEPS);
+  assert(scheduler.getDroppedSteps() == 100 - FrameScheduler::MAX_CATCH_UP_STEPS);
+  assert(scheduler.nextStep() == t0 + milliseconds(1040));
+  scheduler.endFrame(t0 + milliseconds(1035));
+
+  assert(scheduler.getFrames() == 3);
+  assert(scheduler.getSteps() == 3 + FrameScheduler::MAX_CATCH_UP_STEPS);
+
+  // Frame times 25 ms and 1000 ms
+  const auto& histogram = scheduler.getHistogram();
+  assert(histogram[0] == 0);
+  assert(histogram[3] == 1);
+  assert(histogram[FrameScheduler::HISTOGRAM_BUCKETS - 1] == 1);
+
+  // 5 + 5 ms of work in 1035 ms
+  float cpu = scheduler.getCpuUtilisation();
+  assert(cpu > 0.009f && cpu < 0.011f);
+
+  // Sleeping ends at the due time
+  auto due = FrameScheduler::Clock::now() + milliseconds(3);
+  FrameScheduler::sleepUntil(due);
+  assert(FrameScheduler::Clock::now() >= due);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
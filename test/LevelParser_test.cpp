@@ -0,0 +1,154 @@
+/**
+  *   @file LevelParser_test.cpp
+  *   @brief Tests and parse throughput benchmark for LevelParser
+  */
+
+#include "../src/LevelParser.hpp"
+#include <assert.h>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+  *   @brief Build a level file with given amount of entity lines
+  */
+std::string createLevel(unsigned lines)
+{
+  const char* types[] = { "Ground", "RedInfantry", "BlueAntiAircraft", "RedAirplane", "Tree", "InvisibleWall" };
+  std::string content = "Benchmark\n/* Generated\nbenchmark level */\n";
+  for (unsigned i = 0; i < lines; i++)
+  {
+    content += types[i % 6];
+    content += ";" + std::to_string(i % 1200) + "." + std::to_string(i % 10) + ";" + std::to_string(i % 600)
+               + ";" + std::to_string(i % 2) + ";" + std::to_string(19 + i % 80) + ";32\n";
+  }
+  return content;
+}
+
+/**
+  *   @brief The istringstream / std::stod parser World and Level used before LevelParser
+  *   @return Returns the amount of parsed lines
+  */
+unsigned legacyParse(const std::string& content)
+{
+  std::istringstream file(content);
+  std::string line;
+  std::string type;
+  double x = 0, y = 0, width = 0, height = 0;
+  int orientation = 0;
+  unsigned count = 0;
+  bool comments_read = false;
+  while (getline(file, line))
+  {
+    if (! comments_read)
+    {
+      comments_read = line.find("*/") != std::string::npos;
+      continue;
+    }
+    std::istringstream temp_stream(line);
+    std::string split_str;
+    int i = 0;
+    while (getline(temp_stream, split_str, ';'))
+    {
+      switch (i)
+      {
+        case 0: type = split_str; break;
+        case 1: x = std::stod(split_str); break;
+        case 2: y = std::stod(split_str); break;
+        case 3: orientation = std::stoi(split_str); break;
+        case 4: width = std::stod(split_str); break;
+        case 5: height = std::stod(split_str); break;
+      }
+      i++;
+    }
+    if (i == 6 && x + y + width + height + orientation >= 0)
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+int main()
+{
+  std::cout << "LevelParser TEST" << std::endl;
+
+  // Shipped level parses completely
+  LevelParser parser;
+  assert(parser.open("../data/level_files/Testi.txt"));
+  LevelRecord record;
+  unsigned count = 0;
+  while (parser.next(record))
+  {
+    if (count == 0)
+    {
+      assert(record.type == "Ground");
+      assert(record.x == 3 && record.y == 535 && record.orientation == 1);
+      assert(record.width == 1194 && record.height == 65);
+      assert(record.line == 3);
+    }
+    count++;
+  }
+  assert(! parser.failed());
+  assert(count == 12);
+
+  // Missing file
+  assert(! parser.open("../data/level_files/does_not_exist.txt"));
+  assert(parser.failed());
+
+  // Windows line feeds, spaces, empty lines and trailing separator are accepted
+  parser.setContent("Name\r\n/* description */\r\n\r\nRock; 10 ;20.5;0;25;20;\r\n");
+  assert(parser.next(record));
+  assert(record.type == "Rock" && record.x == 10 && record.y == 20.5 && record.orientation == 0);
+  assert(! parser.next(record));
+  assert(! parser.failed());
+
+  // Malformed number is reported with line and field
+  parser.setContent("Name\n/*\nmulti line */\nTree;1;2;1;27;36\nTree;1;2x;1;27;36\nTree;1;2;1;27;36\n");
+  assert(parser.next(record));
+  assert(! parser.next(record));
+  assert(parser.failed());
+  assert(parser.getDiagnostics().size() == 1);
+  assert(parser.getDiagnostics()[0].line == 5);
+  assert(parser.getDiagnostics()[0].field == 2);
+  parser.printDiagnostics(std::cout, "malformed.txt");
+
+  // Wrong field count
+  parser.setContent("Name\n/* */\nTree;1;2;1\n");
+  assert(! parser.next(record));
+  assert(parser.getDiagnostics()[0].line == 3);
+  parser.printDiagnostics(std::cout, "short.txt");
+
+  // Throughput benchmark on a multi-megabyte level
+  const unsigned lines = 200000;
+  std::string content = createLevel(lines);
+  double megabytes = content.size() / (1024.0 * 1024.0);
+
+  auto start = std::chrono::steady_clock::now();
+  parser.setContent(content);
+  count = 0;
+  double checksum = 0;
+  while (parser.next(record))
+  {
+    checksum += record.x;
+    count++;
+  }
+  auto end = std::chrono::steady_clock::now();
+  assert(! parser.failed());
+  assert(count == lines);
+  double parser_seconds = std::chrono::duration<double>(end - start).count();
+
+  start = std::chrono::steady_clock::now();
+  unsigned legacy_count = legacyParse(content);
+  end = std::chrono::steady_clock::now();
+  assert(legacy_count == lines);
+  double legacy_seconds = std::chrono::duration<double>(end - start).count();
+
+  std::cout << "Parsed " << lines << " lines (" << megabytes << " MB, checksum " << checksum << ")" << std::endl;
+  std::cout << "  LevelParser: " << parser_seconds * 1000 << " ms, " << megabytes / parser_seconds << " MB/s" << std::endl;
+  std::cout << "  legacy:      " << legacy_seconds * 1000 << " ms, " << megabytes / legacy_seconds << " MB/s" << std::endl;
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -0,0 +1,68 @@
+/**
+  *   @file Minimap_test.cpp
+  *   @brief Tests for the minimap occupancy grid
+  */
+
+#include "../src/Minimap.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "Minimap TEST" << std::endl;
+
+  Minimap minimap;
+  const sf::Vector2f level(Minimap::COLUMNS * 100.f, Minimap::ROWS * 10.f);
+  minimap.reset(level);
+
+  // Only blue and red units are counted
+  int blue = minimap.insert(Game::TEAM_ID::blue, sf::Vector2f(50.f, 5.f));
+  int red = minimap.insert(Game::TEAM_ID::red, sf::Vector2f(150.f, 5.f));
+  assert(blue == 0);
+  assert(red == 1);
+  assert(minimap.insert(Game::TEAM_ID::all_friend, sf::Vector2f(50.f, 5.f)) == -1);
+  assert(minimap.getCount(blue, Game::TEAM_ID::blue) == 1);
+  assert(minimap.getCount(blue, Game::TEAM_ID::red) == 0);
+
+  // Positions outside the level are clamped to the edge cells
+  assert(minimap.getCell(sf::Vector2f(-10.f, -10.f)) == 0);
+  assert(minimap.getCell(level * 2.f) == Minimap::COLUMNS * Minimap::ROWS - 1);
+
+  // Moving inside a cell changes nothing, crossing moves the count
+  assert(minimap.move(blue, Game::TEAM_ID::blue, sf::Vector2f(99.f, 9.f)) == blue);
+  int next = minimap.move(blue, Game::TEAM_ID::blue, sf::Vector2f(150.f, 15.f));
+  assert(next == Minimap::COLUMNS + 1);
+  assert(minimap.getCount(blue, Game::TEAM_ID::blue) == 0);
+  assert(minimap.getCount(next, Game::TEAM_ID::blue) == 1);
+  minimap.remove(red, Game::TEAM_ID::red);
+  assert(minimap.getCount(red, Game::TEAM_ID::red) == 0);
+  minimap.remove(-1, Game::TEAM_ID::blue);
+
+  // Image has one RGBA pixel per cell
+  std::shared_ptr<const MinimapImage> image = minimap.getImage(0);
+  assert(image->size == sf::Vector2u(Minimap::COLUMNS, Minimap::ROWS));
+  assert(image->pixels.size() == image->size.x * image->size.y * 4u);
+  assert(image->level_size == level);
+  assert(minimap.getImageCount() == 1);
+
+  // Images are made only after changes and at most once per interval
+  assert(minimap.getImage(Minimap::IMAGE_INTERVAL) == image);
+  minimap.move(next, Game::TEAM_ID::blue, sf::Vector2f(5000.f, 5.f));
+  assert(minimap.getImage(Minimap::IMAGE_INTERVAL - 1) == image);
+  std::shared_ptr<const MinimapImage> changed = minimap.getImage(Minimap::IMAGE_INTERVAL);
+  assert(changed != image);
+  assert(minimap.getImageCount() == 2);
+  // Previous image is unchanged for whoever still draws it
+  assert(image->pixels != changed->pixels);
+
+  // Ground is marked under its box
+  minimap.reset(level);
+  minimap.addGround(sf::FloatRect(0.f, level.y - 10.f, level.x, 10.f));
+  image = minimap.getImage(0);
+  std::size_t bottom = (Minimap::ROWS - 1) * Minimap::COLUMNS * 4;
+  assert(image->pixels[bottom + 3] != image->pixels[3]);
+  assert(minimap.getCount(0, Game::TEAM_ID::blue) == 0);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -0,0 +1,63 @@
+/**
+  *   @file ParticleSystem_test.cpp
+  *   @brief Tests for the pooled particle system
+  */
+
+#include "../src/ParticleSystem.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "ParticleSystem TEST" << std::endl;
+
+  // Emitting stays within the step budget, the rest is dropped
+  ParticleSystem particles(1000, 100);
+  for (int i = 0; i < 10; i++)
+  {
+    particles.emit(ParticleSystem::explosion, sf::Vector2f(100.f, 100.f));
+  }
+  assert(particles.size() == 100);
+  assert(particles.getDroppedCount() > 0);
+
+  // Budget is refilled by step
+  long dropped = particles.getDroppedCount();
+  particles.step(1.f / 60);
+  particles.emit(ParticleSystem::muzzle_flash, sf::Vector2f(0.f, 0.f), sf::Vector2f(1.f, 0.f));
+  assert(particles.size() == 104);
+  assert(particles.getDroppedCount() == dropped);
+
+  // Particles move and keep their previous position for interpolation
+  std::vector<ParticleState> states;
+  particles.exportState(states);
+  assert(states.size() == particles.size());
+  bool moved = false;
+  for (const ParticleState& state : states)
+  {
+    moved = moved || state.position != state.previous_position;
+  }
+  assert(moved);
+
+  // Capacity is never exceeded
+  ParticleSystem small(30, 1000);
+  small.emit(ParticleSystem::bomb_blast, sf::Vector2f(0.f, 0.f));
+  small.emit(ParticleSystem::bomb_blast, sf::Vector2f(0.f, 0.f));
+  assert(small.size() == small.capacity());
+
+  // Every particle expires, lifetimes are a few seconds at most
+  for (int i = 0; i < 5 * 60; i++)
+  {
+    particles.step(1.f / 60);
+    small.step(1.f / 60);
+  }
+  assert(particles.size() == 0);
+  assert(small.size() == 0);
+
+  particles.emit(ParticleSystem::explosion, sf::Vector2f(0.f, 0.f));
+  particles.clear();
+  assert(particles.size() == 0);
+  assert(particles.getDroppedCount() == 0);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
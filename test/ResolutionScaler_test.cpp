@@ -0,0 +1,74 @@
+/**
+  *   @file ResolutionScaler_test.cpp
+  *   @brief Tests for the dynamic resolution scale
+  */
+
+#include "../src/ResolutionScaler.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "ResolutionScaler TEST" << std::endl;
+
+  using std::chrono::milliseconds;
+  ResolutionScaler scaler(milliseconds(10));
+  assert(scaler.isAutomatic());
+  assert(scaler.getScale() == ResolutionScaler::MAX_SCALE);
+
+  // Slow frames lower the scale once per sample
+  for (int i = 0; i < ResolutionScaler::SAMPLE_FRAMES - 1; i++)
+  {
+    scaler.addFrame(milliseconds(20));
+  }
+  assert(scaler.getScale() == ResolutionScaler::MAX_SCALE);
+  scaler.addFrame(milliseconds(20));
+  assert(scaler.getScale() < ResolutionScaler::MAX_SCALE);
+  assert(scaler.getChanges() == 1);
+
+  // Never below MIN_SCALE
+  for (int i = 0; i < 100 * ResolutionScaler::SAMPLE_FRAMES; i++)
+  {
+    scaler.addFrame(milliseconds(20));
+  }
+  assert(scaler.getScale() == ResolutionScaler::MIN_SCALE);
+
+  // Frames within the band keep the scale
+  long changes = scaler.getChanges();
+  for (int i = 0; i < 10 * ResolutionScaler::SAMPLE_FRAMES; i++)
+  {
+    scaler.addFrame(milliseconds(8));
+  }
+  assert(scaler.getScale() == ResolutionScaler::MIN_SCALE);
+  assert(scaler.getChanges() == changes);
+
+  // Fast frames raise it back up to the limit
+  for (int i = 0; i < 100 * ResolutionScaler::SAMPLE_FRAMES; i++)
+  {
+    scaler.addFrame(milliseconds(2));
+  }
+  assert(scaler.getScale() == ResolutionScaler::MAX_SCALE);
+
+  // Given scale is the limit of the automatic mode
+  scaler.setScale(0.75f, true);
+  for (int i = 0; i < 100 * ResolutionScaler::SAMPLE_FRAMES; i++)
+  {
+    scaler.addFrame(milliseconds(2));
+  }
+  assert(scaler.getScale() == 0.75f);
+
+  // Fixed scale is clamped and doesn't follow the frames
+  scaler.setScale(0.1f, false);
+  assert(! scaler.isAutomatic());
+  assert(scaler.getScale() == ResolutionScaler::MIN_SCALE);
+  for (int i = 0; i < 10 * ResolutionScaler::SAMPLE_FRAMES; i++)
+  {
+    scaler.addFrame(milliseconds(2));
+  }
+  assert(scaler.getScale() == ResolutionScaler::MIN_SCALE);
+  scaler.setScale(2.f, false);
+  assert(scaler.getScale() == ResolutionScaler::MAX_SCALE);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -0,0 +1,205 @@
+/**
+  *   @file TerrainOutline_test.cpp
+  *   @brief Tests for merging terrain rectangles to outlines
+  */
+
+#include "../src/TerrainOutline.hpp"
+#include "../src/LevelParser.hpp"
+#include "../src/PhysicsWorld.hpp"
+#include <assert.h>
+#include <iostream>
+#include <string>
+
+/**
+  *   @brief Proxies and contacts of a stepped terrain layout
+  */
+struct Layout
+{
+  int proxies = 0;
+  long contacts = 0; /**< Sum over the ticks */
+  long touching = 0; /**< Sum over the ticks */
+};
+
+/**
+  *   @return Returns true if the loop contains the point
+  */
+bool hasVertex(const TerrainLoop& loop, float x, float y)
+{
+  for (const TerrainPoint& point : loop)
+  {
+    if (point.x == x && point.y == y)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+  *   @brief Step units standing on the left edge of every ground box
+  *   @details The left edge of a box is the seam to its neighbour, where
+  *   separate boxes give a unit two contacts.
+  *   @param merged Build the terrain like World::compile_terrain, otherwise
+  *   one box per rectangle
+  *   @return Returns proxies of the terrain and contacts of 60 ticks
+  */
+Layout stepLayout(const std::vector<TerrainRect>& ground, const std::vector<TerrainRect>& walls, bool merged)
+{
+  const float unit = 10.f;
+  PhysicsWorld physics;
+  b2Body* terrain = physics.create_body_terrain();
+  std::vector<b2Fixture*> fixtures;
+  for (const auto& rects : { ground, walls })
+  {
+    if (! merged)
+    {
+      for (const TerrainRect& rect : rects)
+      {
+        fixtures.push_back(physics.add_terrain_box(terrain, rect));
+      }
+      continue;
+    }
+    for (const TerrainGroup& group : Terrain::merge(rects))
+    {
+      if (Terrain::countEdges(group.loops) >= group.rects.size())
+      {
+        for (std::size_t index : group.rects)
+        {
+          fixtures.push_back(physics.add_terrain_box(terrain, rects[index]));
+        }
+        continue;
+      }
+      for (const TerrainLoop& loop : group.loops)
+      {
+        fixtures.push_back(physics.add_terrain_loop(terrain, loop));
+      }
+    }
+  }
+  Layout layout;
+  for (b2Fixture* fixture : fixtures)
+  {
+    layout.proxies += fixture->GetShape()->GetChildCount();
+  }
+
+  Collision::Bits bits = Collision::getBits(Collision::ground_unit, Game::TEAM_ID::blue);
+  for (const TerrainRect& rect : ground)
+  {
+    b2BodyDef body;
+    body.type = b2_dynamicBody;
+    body.position.Set(rect.left / Game::TOPIXELS, (rect.top - unit / 2) / Game::TOPIXELS);
+    b2PolygonShape shape;
+    shape.SetAsBox(unit / 2 / Game::TOPIXELS, unit / 2 / Game::TOPIXELS);
+    b2FixtureDef fixture;
+    fixture.shape = &shape;
+    fixture.density = 1.f;
+    fixture.filter.categoryBits = bits.category;
+    fixture.filter.maskBits = bits.mask;
+    physics.get_world()->CreateBody(&body)->CreateFixture(&fixture);
+  }
+  for (int i = 0; i < 60; i++)
+  {
+    physics.get_world()->Step(1/60.f, 8, 3);
+    layout.contacts += physics.get_world()->GetContactCount();
+    for (b2Contact* contact = physics.get_world()->GetContactList(); contact != nullptr; contact = contact->GetNext())
+    {
+      layout.touching += contact->IsTouching() ? 1 : 0;
+    }
+  }
+  return layout;
+}
+
+int main()
+{
+  std::cout << "TerrainOutline TEST" << std::endl;
+
+  // Single rectangle is its own four edge loop
+  std::vector<TerrainGroup> groups = Terrain::merge({ {0, 500, 100, 100} });
+  assert(groups.size() == 1);
+  assert(groups[0].loops.size() == 1);
+  assert(groups[0].loops[0].size() == 4);
+
+  // Row of ground segments merges to one rectangle, internal edges disappear
+  std::vector<TerrainRect> row;
+  for (int i = 0; i < 50; i++)
+  {
+    row.push_back({i * 24.f, 535, 24, 65});
+  }
+  groups = Terrain::merge(row);
+  assert(groups.size() == 1);
+  assert(groups[0].rects.size() == 50);
+  assert(groups[0].loops.size() == 1);
+  assert(groups[0].loops[0].size() == 4);
+  assert(hasVertex(groups[0].loops[0], 0, 535));
+  assert(hasVertex(groups[0].loops[0], 1200, 600));
+
+  // Step in the ground gives an L-shape with six vertices
+  groups = Terrain::merge({ {0, 500, 100, 100}, {100, 550, 100, 50} });
+  assert(groups.size() == 1 && groups[0].loops.size() == 1);
+  assert(groups[0].loops[0].size() == 6);
+
+  // Separate rectangles stay in separate groups, empty ones are ignored
+  groups = Terrain::merge({ {0, 0, 10, 10}, {20, 0, 10, 10}, {40, 0, 0, 10} });
+  assert(groups.size() == 2);
+  assert(groups[0].rects[0] == 0 && groups[1].rects[0] == 1);
+
+  // Frame of walls has an outer outline and a hole
+  groups = Terrain::merge({ {0, 0, 100, 1}, {0, 99, 100, 1}, {0, 0, 1, 100}, {99, 0, 1, 100} });
+  assert(groups.size() == 1);
+  assert(groups[0].loops.size() == 2);
+  assert(Terrain::countEdges(groups[0].loops) == 8);
+
+  // Rectangles touching only by a corner give two loops
+  groups = Terrain::merge({ {0, 0, 10, 10}, {10, 10, 10, 10} });
+  assert(groups.size() == 1);
+  assert(groups[0].loops.size() == 2);
+  assert(groups[0].loops[0].size() == 4 && groups[0].loops[1].size() == 4);
+
+  // Shipped levels, every ground/wall box is one broadphase proxy without merging
+  for (std::string name : { "Testi", "AChallenge", "DestroyBase" })
+  {
+    LevelParser parser;
+    assert(parser.open("../data/level_files/" + name + ".txt"));
+    std::vector<TerrainRect> ground;
+    std::vector<TerrainRect> walls;
+    LevelRecord record;
+    while (parser.next(record))
+    {
+      TerrainRect rect = {static_cast<float>(record.x), static_cast<float>(record.y),
+                          static_cast<float>(record.width), static_cast<float>(record.height)};
+      if (record.type == "Ground")
+      {
+        ground.push_back(rect);
+      }
+      else if (record.type == "InvisibleWall")
+      {
+        walls.push_back(rect);
+      }
+    }
+    assert(! parser.failed());
+    std::size_t outlines = 0;
+    for (const auto& rects : { ground, walls })
+    {
+      for (const TerrainGroup& group : Terrain::merge(rects))
+      {
+        outlines += group.loops.size();
+        for (const TerrainLoop& loop : group.loops)
+        {
+          assert(loop.size() >= 4);
+        }
+      }
+    }
+    Layout boxes = stepLayout(ground, walls, false);
+    Layout merged = stepLayout(ground, walls, true);
+    assert(boxes.proxies == static_cast<int>(ground.size() + walls.size()));
+    assert(merged.proxies <= boxes.proxies);
+    assert(merged.touching > 0);
+    std::cout << name << ": " << ground.size() << " ground and " << walls.size()
+              << " wall boxes merged to " << outlines << " outlines, proxies "
+              << boxes.proxies << " -> " << merged.proxies << ", contacts in 60 ticks "
+              << boxes.contacts << " -> " << merged.contacts << " (touching "
+              << boxes.touching << " -> " << merged.touching << ")" << std::endl;
+  }
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
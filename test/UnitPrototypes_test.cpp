@@ -0,0 +1,56 @@
+/**
+  *   @file UnitPrototypes_test.cpp
+  *   @brief Tests for the unit prototype table
+  */
+
+#include "../src/UnitPrototypes.hpp"
+#include <assert.h>
+#include <iostream>
+
+int main()
+{
+  std::cout << "UnitPrototypes TEST" << std::endl;
+
+  // Every level entity has a prototype, indexed by its own texture
+  int prototypes = 0;
+  for (const auto& entry : Textures::alphaTextures)
+  {
+    const Units::Prototype* prototype = Units::get(entry.second);
+    if (entry.second == Textures::Bullet_alpha)
+    {
+      // Bullets aren't placed to the level as entities
+      assert(prototype == nullptr);
+      continue;
+    }
+    assert(prototype != nullptr);
+    assert(prototype->texture == entry.second);
+    assert(prototype->factory != nullptr);
+    assert(prototype->hit_points > 0);
+    prototypes++;
+  }
+  assert(prototypes == 14);
+  assert(Units::get(Textures::std_button) == nullptr);
+
+  // Only moving units are dynamic, artillery is static
+  assert(Units::get(Textures::BlueAirplane_alpha)->body == b2_dynamicBody);
+  assert(Units::get(Textures::RedInfantry_alpha)->body == b2_dynamicBody);
+  assert(Units::get(Textures::RedAntiAircraft_alpha)->body == b2_staticBody);
+  assert(Units::get(Textures::RedAntiAircraft_alpha)->sensor_radius > 0);
+  assert(Units::get(Textures::BlueHangar_alpha)->sensor_radius == 0);
+  assert(Units::get(Textures::Ground_alpha)->shape == Units::terrain);
+
+  // Structures and terrain are scenery, units and artillery are drawn every frame
+  assert(Units::get(Textures::Ground_alpha)->scenery);
+  assert(Units::get(Textures::BlueHangar_alpha)->scenery);
+  assert(Units::get(Textures::InvisibleWall_alpha)->scenery);
+  assert(! Units::get(Textures::RedAntiAircraft_alpha)->scenery);
+  assert(! Units::get(Textures::BlueInfantry_alpha)->scenery);
+
+  // Teams match the texture names
+  assert(Units::get(Textures::RedAirplane_alpha)->team == Game::TEAM_ID::red);
+  assert(Units::get(Textures::BlueBase_alpha)->team == Game::TEAM_ID::blue);
+  assert(Units::get(Textures::Tree_alpha)->team == Game::TEAM_ID::all_friend);
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
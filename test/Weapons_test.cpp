@@ -0,0 +1,296 @@
+/**
+  *   @file Weapons_test.cpp
+  *   @brief Projectile spec checks and heavy fire contact benchmark
+  *   @details Fires the same salvoes with projectile fixtures sized as the
+  *   shooter sprite (the old behaviour) and sized by Weapons::Projectiles,
+  *   and compares Box2D contact counts and step time. The same salvoes are
+  *   then fired through ProjectileSystem, which has no projectile bodies.
+  *   The carpet bombing benchmark compares blast queries against a loop over
+  *   all entities.
+  */
+
+#include "../src/CommonDefinitions.hpp"
+#include "../src/CollisionFilter.hpp"
+#include "../src/ProjectileSystem.hpp"
+#include <Box2D/Box2D.h>
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/**
+  *   @struct BenchmarkResult
+  *   @brief Counters of one benchmark run
+  */
+struct BenchmarkResult
+{
+  long total_contacts = 0;
+  int peak_contacts = 0;
+  long fired = 0;
+  long hits = 0;
+  double seconds = 0;
+};
+
+/**
+  *   @brief Create a box fixture body
+  */
+b2Body* createBox(b2World& world, b2BodyType type, float x, float y, float width, float height, Collision::Bits bits)
+{
+  b2BodyDef body_def;
+  body_def.type = type;
+  body_def.position = b2Vec2(x * Game::TOMETERS, y * Game::TOMETERS);
+  b2Body* body = world.CreateBody(&body_def);
+  b2PolygonShape shape;
+  shape.SetAsBox(width / 2 * Game::TOMETERS, height / 2 * Game::TOMETERS);
+  b2FixtureDef fixture_def;
+  fixture_def.shape = &shape;
+  fixture_def.density = 1.f;
+  fixture_def.filter.categoryBits = bits.category;
+  fixture_def.filter.maskBits = bits.mask;
+  body->CreateFixture(&fixture_def);
+  return body;
+}
+
+/**
+  *   @brief Blue guns on the ground, red planes hovering above them
+  *   @return Returns the gun bodies
+  */
+std::vector<b2Body*> createScene(b2World& world)
+{
+  createBox(world, b2_staticBody, Game::WIDTH / 2.f, 567.f, Game::WIDTH, 65.f, Collision::getBits(Collision::terrain));
+  std::vector<b2Body*> guns;
+  for (int i = 0; i < 40; i++)
+  {
+    guns.push_back(createBox(world, b2_dynamicBody, 15.f + i * 30.f, 519.f, 36.f, 31.f,
+                             Collision::getBits(Collision::ground_unit, Game::TEAM_ID::blue)));
+  }
+  for (int i = 0; i < 60; i++)
+  {
+    b2Body* plane = createBox(world, b2_dynamicBody, 10.f + i * 20.f, 100.f + (i % 5) * 40.f, 38.f, 18.f,
+                              Collision::getBits(Collision::aircraft, Game::TEAM_ID::red));
+    plane->SetGravityScale(0.f);
+  }
+  return guns;
+}
+
+/**
+  *   @brief Direction of the i:th gun in a salvo, the salvo spreads a little
+  */
+b2Vec2 salvoDirection(std::size_t i)
+{
+  b2Vec2 direction((static_cast<int>(i % 7) - 3) * 0.1f, -1.f);
+  direction.Normalize();
+  return direction;
+}
+
+/**
+  *   @brief Anti aircraft guns fire at a swarm of planes for ten seconds
+  *   @param bullet_width Projectile fixture width in pixels
+  *   @param bullet_height Projectile fixture height in pixels
+  */
+BenchmarkResult heavyFire(float bullet_width, float bullet_height)
+{
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[Weapons::anti_aircraft_gun];
+  b2World world(b2Vec2(0.f, Game::GRAVITY));
+  std::vector<b2Body*> guns = createScene(world);
+
+  std::vector<b2Body*> bullets;
+  BenchmarkResult result;
+  const int ticks = 600;
+  const int fire_ticks = static_cast<int>(spec.fire_interval * 60);
+  auto start = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++)
+  {
+    if (tick % fire_ticks == 0)
+    {
+      for (std::size_t i = 0; i < guns.size(); i++)
+      {
+        b2Vec2 muzzle = guns[i]->GetPosition() - b2Vec2(0.f, (31.f / 2 + bullet_height / 2 + spec.muzzle_offset) * Game::TOMETERS);
+        b2Body* bullet = createBox(world, b2_dynamicBody, muzzle.x * Game::TOPIXELS, muzzle.y * Game::TOPIXELS,
+                                   bullet_width, bullet_height, Collision::getBits(Collision::projectile));
+        bullet->SetBullet(true);
+        bullet->SetGravityScale(spec.gravity_scale);
+        bullet->GetFixtureList()->SetDensity(0.f);
+        bullet->ResetMassData();
+        bullet->ApplyLinearImpulse(spec.impulse * salvoDirection(i), bullet->GetWorldCenter(), true);
+        bullets.push_back(bullet);
+        result.fired++;
+      }
+    }
+    world.Step(1 / 60.f, 8, 3);
+    result.total_contacts += world.GetContactCount();
+    result.peak_contacts = std::max(result.peak_contacts, world.GetContactCount());
+
+    // Bullets are removed on hit or when they leave the level, as in World
+    for (auto it = bullets.begin(); it != bullets.end(); )
+    {
+      b2Body* bullet = *it;
+      bool hit = false;
+      for (b2ContactEdge* edge = bullet->GetContactList(); edge != nullptr; edge = edge->next)
+      {
+        hit = hit || edge->contact->IsTouching();
+      }
+      b2Vec2 position = bullet->GetPosition();
+      bool out = position.y < 0 || position.x < 0 || position.x * Game::TOPIXELS > Game::WIDTH;
+      result.hits += hit ? 1 : 0;
+      if (hit || out)
+      {
+        world.DestroyBody(bullet);
+        it = bullets.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+/**
+  *   @brief Same salvoes as heavyFire, fired through ProjectileSystem
+  */
+BenchmarkResult heavyFireAnalytic()
+{
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[Weapons::anti_aircraft_gun];
+  b2World world(b2Vec2(0.f, Game::GRAVITY));
+  std::vector<b2Body*> guns = createScene(world);
+  ProjectileSystem projectiles(&world);
+  std::vector<ProjectileHit> hits;
+
+  BenchmarkResult result;
+  const int ticks = 600;
+  const int fire_ticks = static_cast<int>(spec.fire_interval * 60);
+  auto start = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++)
+  {
+    if (tick % fire_ticks == 0)
+    {
+      for (std::size_t i = 0; i < guns.size(); i++)
+      {
+        b2Vec2 muzzle = guns[i]->GetPosition() - b2Vec2(0.f, (31.f / 2 + spec.height / 2 + spec.muzzle_offset) * Game::TOMETERS);
+        projectiles.spawn(Weapons::anti_aircraft_gun, muzzle, spec.impulse * salvoDirection(i), nullptr, 0);
+        result.fired++;
+      }
+    }
+    world.Step(1 / 60.f, 8, 3);
+    hits.clear();
+    projectiles.step(1 / 60.f, Game::WIDTH, hits);
+    result.hits += hits.size();
+    result.total_contacts += world.GetContactCount();
+    result.peak_contacts = std::max(result.peak_contacts, world.GetContactCount());
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  assert(projectiles.size() + projectiles.getExpiredCount() + projectiles.getOutOfBoundsCount() + result.hits
+         == static_cast<std::size_t>(result.fired));
+  return result;
+}
+
+/**
+  *   @brief Hundreds of bombs explode over dense infantry formations
+  *   @details Every blast is resolved with ProjectileSystem::queryBlast and
+  *   with a distance check against every infantry body
+  */
+void carpetBombing()
+{
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[Weapons::bomb];
+  const float radius = spec.blast_radius * Game::TOMETERS;
+  b2World world(b2Vec2(0.f, Game::GRAVITY));
+  createBox(world, b2_staticBody, 5000.f, 567.f, 10000.f, 65.f, Collision::getBits(Collision::terrain));
+
+  // Ten rows of infantry shoulder to shoulder
+  std::vector<b2Body*> infantry;
+  for (int row = 0; row < 10; row++)
+  {
+    for (int i = 0; i < 400; i++)
+    {
+      infantry.push_back(createBox(world, b2_dynamicBody, 10.f + i * 24.f, 524.f - row * 22.f, 12.f, 20.f,
+                                   Collision::getBits(Collision::ground_unit, row % 2 ? Game::TEAM_ID::red : Game::TEAM_ID::blue)));
+    }
+  }
+  world.Step(1 / 60.f, 8, 3);
+
+  std::vector<b2Vec2> blasts;
+  for (int i = 0; i < 500; i++)
+  {
+    blasts.emplace_back((10.f + i * 19.f) * Game::TOMETERS, (430.f + (i % 9) * 10.f) * Game::TOMETERS);
+  }
+
+  // Batched broadphase queries
+  ProjectileSystem projectiles(&world);
+  std::vector<b2Fixture*> fixtures;
+  long queried = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const b2Vec2& center : blasts)
+  {
+    fixtures.clear();
+    projectiles.queryBlast(center, radius, fixtures);
+    for (b2Fixture* fixture : fixtures)
+    {
+      queried += fixture->GetBody()->GetType() == b2_dynamicBody ? 1 : 0;
+    }
+  }
+  double query_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Distance check against every entity
+  long looped = 0;
+  start = std::chrono::steady_clock::now();
+  for (const b2Vec2& center : blasts)
+  {
+    for (b2Body* body : infantry)
+    {
+      const b2AABB& box = body->GetFixtureList()->GetAABB(0);
+      b2Vec2 closest(std::min(std::max(center.x, box.lowerBound.x), box.upperBound.x),
+                     std::min(std::max(center.y, box.lowerBound.y), box.upperBound.y));
+      looped += b2DistanceSquared(center, closest) <= radius * radius ? 1 : 0;
+    }
+  }
+  double loop_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  assert(queried == looped);
+  assert(queried > 0);
+  std::cout << "Carpet bombing, " << blasts.size() << " blasts over " << infantry.size() << " infantry, "
+            << queried << " hits" << std::endl;
+  std::cout << "  QueryAABB + radius: " << query_seconds * 1000 << " ms" << std::endl;
+  std::cout << "  loop over entities: " << loop_seconds * 1000 << " ms" << std::endl;
+}
+
+int main()
+{
+  std::cout << "Weapons TEST" << std::endl;
+
+  // Specs are sane and smaller than any shooter sprite
+  for (int weapon = 0; weapon < Weapons::weapon_id_end; weapon++)
+  {
+    const Weapons::ProjectileSpec& spec = Weapons::Projectiles[weapon];
+    assert(spec.width > 0 && spec.height > 0);
+    assert(spec.width <= 19 && spec.height <= 18);
+    assert(spec.impulse >= 0 && spec.damage > 0 && spec.fire_interval > 0 && spec.blast_radius >= 0);
+  }
+
+  const Weapons::ProjectileSpec& spec = Weapons::Projectiles[Weapons::anti_aircraft_gun];
+  BenchmarkResult sprite_sized = heavyFire(36.f, 31.f);
+  BenchmarkResult spec_sized = heavyFire(spec.width, spec.height);
+  assert(sprite_sized.fired == spec_sized.fired);
+  assert(spec_sized.total_contacts <= sprite_sized.total_contacts);
+  BenchmarkResult analytic = heavyFireAnalytic();
+  assert(analytic.fired == spec_sized.fired);
+  // projectiles add no contacts, only the scene itself has them
+  assert(analytic.total_contacts <= spec_sized.total_contacts);
+
+  std::cout << "Heavy fire, " << spec_sized.fired << " projectiles in 600 ticks" << std::endl;
+  std::cout << "  sprite sized (36x31): contacts " << sprite_sized.total_contacts << " total, "
+            << sprite_sized.peak_contacts << " peak, " << sprite_sized.seconds * 1000 << " ms" << std::endl;
+  std::cout << "  spec sized (" << spec.width << "x" << spec.height << "):    contacts " << spec_sized.total_contacts << " total, "
+            << spec_sized.peak_contacts << " peak, " << spec_sized.seconds * 1000 << " ms" << std::endl;
+  std::cout << "  analytic ray cast:    contacts " << analytic.total_contacts << " total, "
+            << analytic.peak_contacts << " peak, " << analytic.seconds * 1000 << " ms, "
+            << analytic.hits << " hits (bodies " << spec_sized.hits << ")" << std::endl;
+
+  carpetBombing();
+
+  std::cout << "Asserts ok, test completed successfully" << std::endl;
+  return 0;
+}
@@ -2,6 +2,7 @@
 #include "../src/World.hpp"
 #include "../src/ResourceManager.hpp"
 #include "../src/GameEngine.hpp"
+#include <cassert>
 
 
 int main() {
@@ -14,6 +15,74 @@ int main() {
 	ResourceManager manager = ResourceManager();
 	World world(window,manager);
 	world.read_level(str, Game::GameMode::SinglePlayer);
+
+	// Static guns rest on the ground, in Testi guns end at y 534 and the ground starts at 535
+	int guns = 0;
+	for (auto& it : world.get_all_entities()) {
+		if (it->getTypeId() == Game::TYPE_ID::antiaircraft) {
+			float bottom = Game::TOPIXELS * it->getB2Body()->GetPosition().y + 31.f / 2;
+			assert(bottom > 534.5f && bottom <= 535.f);
+			guns++;
+		}
+	}
+	assert(guns == 2);
+
+	// Snapshot restores the level as it was taken
+	WorldSnapshot snapshot;
+	world.take_snapshot(snapshot, str, Game::GameMode::SinglePlayer);
+	std::vector<b2Vec2> positions;
+	for (auto& it : world.get_all_entities()) {
+		positions.push_back(it->getB2Body()->GetPosition());
+	}
+	std::vector<Textures::ID> planes;
+	std::vector<b2Vec2> plane_positions;
+	for (auto& it : world.get_player_planes()) {
+		planes.push_back(it->getType());
+		plane_positions.push_back(it->getB2Body()->GetPosition());
+	}
+	assert(! positions.empty());
+	assert(! planes.empty());
+	world.remove_entity(world.get_all_entities().back().get());
+	for (int i = 0; i < 60; i++) {
+		world.update(Game::GameMode::SinglePlayer);
+	}
+	assert(world.get_all_entities().size() == positions.size() - 1);
+	assert(world.restore_snapshot(snapshot));
+	assert(world.get_all_entities().size() == positions.size());
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		b2Vec2 position = world.get_all_entities()[i]->getB2Body()->GetPosition();
+		assert(position.x == positions[i].x && position.y == positions[i].y);
+	}
+	assert(world.get_player_planes().size() == planes.size());
+	for (std::size_t i = 0; i < planes.size(); i++) {
+		assert(world.get_player_planes()[i]->getType() == planes[i]);
+		b2Vec2 position = world.get_player_planes()[i]->getB2Body()->GetPosition();
+		assert(position.x == plane_positions[i].x && position.y == plane_positions[i].y);
+	}
+
+	// Restored plane fires through the projectile system, the cooldown holds the next shot
+	Entity& player = *world.get_player_planes().front();
+	assert(player.shoot(sf::Vector2f(1.f, 0.f)));
+	assert(! player.shoot(sf::Vector2f(1.f, 0.f)));
 	world.update(Game::GameMode::SinglePlayer);
-	window.display();
+	assert(world.getStats().live_bullets == 1);
+	const WorldStats& stats = world.getStats();
+	assert(stats.active_entities <= stats.entities && stats.active_bodies <= stats.bodies);
+	std::cout << "Active entities " << stats.active_entities << " of " << stats.entities << ", active bodies "
+	          << stats.active_bodies << " of " << stats.bodies << std::endl;
+	RenderFrame frame;
+	world.publish(frame, sf::FloatRect(0, 0, Game::WIDTH, Game::HEIGHT));
+	assert(! frame.sprites.empty());
+	// scenery is shared until a static entity is destroyed
+	assert(frame.scenery != nullptr);
+	RenderFrame next;
+	world.publish(next, sf::FloatRect(0, 0, Game::WIDTH, Game::HEIGHT));
+	assert(next.scenery == frame.scenery);
+
+	// Only the hit that takes the last hit points kills
+	Entity& target = *world.get_all_entities().back();
+	assert(target.damage(target.getHitPoints()));
+	assert(! target.damage(1));
+
+	std::cout << "Asserts ok, test completed successfully" << std::endl;
 }